@@ -0,0 +1,150 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Hardware event counters for the benchmarks, read through Linux
+// perf_event_open. Each counter is opened on its own for the calling thread
+// (user space only, so the default perf_event_paranoid level allows it); any
+// that the kernel, CPU or container refuses are simply reported as missing.
+// On other systems every counter is missing.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounters
+{
+public:
+    enum Event
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS
+    };
+
+    PerfCounters()
+    {
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            fds[e] = -1;
+            values[e] = 0;
+        }
+#ifdef __linux__
+        const uint32_t types[NUM_EVENTS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE,
+                                            PERF_TYPE_HARDWARE};
+        const uint64_t configs[NUM_EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = types[e];
+            attr.config = configs[e];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            // Scale counts if the kernel has to multiplex the counters.
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters()
+    {
+#ifdef __linux__
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            if (fds[e] >= 0)
+                close(fds[e]);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available(Event e) const { return fds[e] >= 0; }
+
+    bool anyAvailable() const
+    {
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            if (available(static_cast<Event>(e)))
+                return true;
+        }
+        return false;
+    }
+
+    void start()
+    {
+#ifdef __linux__
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            if (fds[e] < 0)
+                continue;
+            ioctl(fds[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop()
+    {
+#ifdef __linux__
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            if (fds[e] < 0)
+                continue;
+            ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t data[3] = {0, 0, 0}; // value, time enabled, time running
+            if (read(fds[e], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0)
+            {
+                values[e] = 0;
+                continue;
+            }
+            values[e] = data[2] < data[1] ? static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]) : data[0];
+        }
+#endif
+    }
+
+    uint64_t value(Event e) const { return values[e]; }
+
+    // One line with IPC and per-operation event counts for the last
+    // start/stop interval, or nothing if no counter is available.
+    void print(uint64_t operations, const char *unit) const
+    {
+        if (!anyAvailable() || operations == 0)
+            return;
+        std::printf("%24s", "");
+        if (available(CYCLES) && available(INSTRUCTIONS) && values[CYCLES] > 0)
+            std::printf("IPC %5.2f   ", static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES]);
+        if (available(CYCLES))
+            std::printf("cycles/%s %7.2f   ", unit, static_cast<double>(values[CYCLES]) / operations);
+        if (available(L1D_MISSES))
+            std::printf("L1D miss/%s %6.3f   ", unit, static_cast<double>(values[L1D_MISSES]) / operations);
+        if (available(LLC_MISSES))
+            std::printf("LLC miss/%s %6.3f   ", unit, static_cast<double>(values[LLC_MISSES]) / operations);
+        if (available(BRANCH_MISSES))
+            std::printf("branch miss/%s %6.3f", unit, static_cast<double>(values[BRANCH_MISSES]) / operations);
+        std::printf("\n");
+    }
+
+private:
+    int fds[NUM_EVENTS];
+    uint64_t values[NUM_EVENTS];
+};
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,134 @@
+// Micro-benchmarks for move application on every model and for the batch
+// kernels. Build and run with `make bench`. Where Linux allows it, each
+// measurement is followed by a line of hardware counter results.
+#include "CubieCube.h"
+#include "Kernels.h"
+#include "PerfCounters.h"
+#include "RubiksCube1DArray.h"
+#include "RubiksCube3DArray.h"
+#include "RubiksCubeBitboard.h"
+#include "ScrambleGenerator.h"
+#include "StickerBatch.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static double elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Applies a long move list one move at a time through the virtual interface
+// and in bulk through apply().
+template <typename T>
+static void benchModel(const char *name, const std::vector<Move> &moves, PerfCounters &counters)
+{
+    T cube;
+    counters.start();
+    auto start = std::chrono::steady_clock::now();
+    RubiksCube &base = cube;
+    for (Move m : moves)
+        base.move(m);
+    double virtualNs = elapsedNs(start) / moves.size();
+    counters.stop();
+    std::printf("%-22s move():  %7.2f ns/move\n", name, virtualNs);
+    counters.print(moves.size(), "move");
+
+    counters.start();
+    start = std::chrono::steady_clock::now();
+    cube.apply(moves.data(), moves.size());
+    double bulkNs = elapsedNs(start) / moves.size();
+    counters.stop();
+    std::printf("%-22s apply(): %7.2f ns/move   (solved=%d)\n", name, bulkNs, cube.isSolved());
+    counters.print(moves.size(), "move");
+}
+
+static void benchCubie(const std::vector<Move> &moves, PerfCounters &counters)
+{
+    CubieCube cube;
+    counters.start();
+    auto start = std::chrono::steady_clock::now();
+    cube.apply(moves.data(), moves.size());
+    double ns = elapsedNs(start) / moves.size();
+    counters.stop();
+    std::printf("%-22s apply(): %7.2f ns/move   (solved=%d)\n", "CubieCube", ns, cube.isSolved());
+    counters.print(moves.size(), "move");
+}
+
+// Runs the batch kernels of one variant directly, bypassing the startup choice.
+static void benchKernel(size_t variant, const std::vector<Move> &moves, size_t batchSize, PerfCounters &counters)
+{
+    const KernelTable &kernels = kernelVariant(variant);
+    StickerBatch batch(batchSize);
+
+    // Laid out as permuteSequence takes them: one control per move, in move order.
+    std::vector<uint8_t> controls(NUM_MOVES * KERNEL_CONTROL_BYTES);
+    for (int i = 0; i < NUM_MOVES; i++)
+    {
+        uint8_t source[KERNEL_ROW_BYTES];
+        CubeTransform t = CubeTransform::fromMove(static_cast<Move>(i));
+        for (size_t j = 0; j < KERNEL_ROW_BYTES; j++)
+            source[j] = j < static_cast<size_t>(RubiksCube::NUM_STICKERS) ? t.data()[j] : static_cast<uint8_t>(j);
+        kernels.preparePermute(source, controls.data() + i * KERNEL_CONTROL_BYTES);
+    }
+
+    size_t rounds = moves.size() / batchSize + 1;
+    counters.start();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++)
+        kernels.permuteRows(controls.data() + static_cast<size_t>(moves[r]) * KERNEL_CONTROL_BYTES, batch.row(0), batchSize);
+    double permuteNs = elapsedNs(start) / (rounds * batchSize);
+    counters.stop();
+    std::printf("kernel %-15s move:    %6.2f ns/cube%s\n", kernels.name, permuteNs, &kernels == &activeKernels() ? "   <- selected" : "");
+    counters.print(rounds * batchSize, "cube");
+
+    counters.start();
+    start = std::chrono::steady_clock::now();
+    size_t solved = 0;
+    for (size_t r = 0; r < rounds; r++)
+        solved += kernels.countEqualRows(batch.row(0), batchSize, batch.row(0));
+    double compareNs = elapsedNs(start) / (rounds * batchSize);
+    counters.stop();
+    std::printf("kernel %-15s compare: %6.2f ns/cube\n", kernels.name, compareNs);
+    counters.print(rounds * batchSize, "cube");
+    if (solved == 0)
+        std::printf("(unexpected compare result)\n");
+
+    if (kernels.permuteSequence == nullptr)
+        return;
+    counters.start();
+    start = std::chrono::steady_clock::now();
+    kernels.permuteSequence(controls.data(), moves.data(), moves.size(), batch.row(0));
+    double sequenceNs = elapsedNs(start) / moves.size();
+    counters.stop();
+    std::printf("kernel %-15s sequence: %5.2f ns/move\n", kernels.name, sequenceNs);
+    counters.print(moves.size(), "move");
+}
+
+int main()
+{
+    const size_t numMoves = 4000000;
+    std::vector<Move> moves(numMoves);
+    ScrambleGenerator generator(2024);
+    generator.randomMoves(moves.data(), numMoves);
+
+    PerfCounters counters;
+    std::printf("Selected batch kernel: %s\n", activeKernels().name);
+    std::printf("Sticker model apply(): %s\n", activeKernels().permuteSequence ? "kernel for long sequences" : "sticker cycles");
+    std::printf("Hardware counters: %s\n\n", counters.anyAvailable() ? "on" : "unavailable (perf_event_open refused; check perf_event_paranoid or container limits)");
+
+    benchModel<RubiksCube1DArray>("RubiksCube1DArray", moves, counters);
+    benchModel<RubiksCube3DArray>("RubiksCube3DArray", moves, counters);
+    benchModel<RubiksCubeBitboard>("RubiksCubeBitboard", moves, counters);
+    benchCubie(moves, counters);
+    std::printf("\n");
+
+    for (size_t i = 0; i < availableKernelCount(); i++)
+    {
+        if (kernelSupported(i))
+            benchKernel(i, moves, 4096, counters);
+        else
+            std::printf("kernel %-15s not supported on this CPU\n", kernelVariant(i).name);
+    }
+    return 0;
+}
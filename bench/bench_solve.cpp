@@ -0,0 +1,469 @@
+// End-to-end solve benchmark on the fixed corpus in bench/solve_corpus_v*.txt.
+// Every solver runs on every position it can handle; per solver and group it
+// records the wall time per solve, the nodes expanded (for the searching
+// solvers) and the solution length, and compares them with a baseline
+// recorded earlier. Run it with `make bench-solve`.
+//
+//   bench_solve CORPUS [--baseline FILE] [--threshold PCT] [--min-millis MS] [--noise-millis MS]
+//               [--output FILE] [--update]
+//
+// Exits with 1 if a solver failed on a position, expanded more nodes or
+// returned longer solutions on a group than the baseline, or became slower
+// on a group by more than PCT percent (default 25) and more than the noise
+// floor (default 1 ms). Nodes and moves are deterministic and always
+// compared; times only for groups taking at least --min-millis (default
+// 10 ms) in the baseline, as shorter ones vary by more than the threshold
+// from run to run. A group that looks slower is timed again up to
+// RETIMES times and keeps its best time, since a busy machine only ever
+// makes a run slower. Times in a baseline are only meaningful on the
+// machine that recorded it; elsewhere, record one first. --update writes
+// the results to the baseline file instead of comparing.
+#include "CfopSolver.h"
+#include "CubieCube.h"
+#include "IDAstarSolver.h"
+#include "RubiksCubeBitboard.h"
+#include "ThistlethwaiteSolver.h"
+#include "TwoPhaseSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// IDA* with the sticker heuristic is only practical on short scrambles.
+static constexpr int IDA_STAR_MAX_DEPTH = 6;
+
+// A timed batch of solves should take at least this long, so fast solvers
+// are repeated and their times are not lost in the clock resolution. The
+// time per solve is the median over the batches.
+static constexpr double MIN_BATCH_MILLIS = 5.0;
+static constexpr int BATCHES = 15;
+
+// How many more times a group that looks slower than the baseline is timed.
+static constexpr int RETIMES = 2;
+
+struct CorpusCase
+{
+    std::string group;
+    std::string name;
+    std::vector<Move> scramble;
+    int depth; // from a depth-N group name, INT_MAX otherwise
+};
+
+struct Corpus
+{
+    int version = 0;
+    std::vector<CorpusCase> cases;
+    std::vector<std::string> groups; // in order of first appearance
+};
+
+// One solve: the solution, and the nodes it expanded or -1 if the solver
+// does not search.
+struct SolveRun
+{
+    bool solved;
+    std::vector<Move> solution;
+    long long nodes;
+};
+
+struct GroupRecord
+{
+    std::string solver;
+    std::string group;
+    int cases = 0;
+    double millis = 0; // sum over the cases of the time per solve
+    long long nodes = -1;
+    long long moves = 0;
+    int failures = 0;
+};
+
+struct BenchSolver
+{
+    const char *name;
+    std::function<void()> prepare;
+    std::function<bool(const CorpusCase &)> handles;
+    std::function<SolveRun(const CorpusCase &, const CubieCube &)> solve;
+};
+
+static bool readCorpus(const std::string &path, Corpus &corpus)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::fprintf(stderr, "Cannot read corpus %s\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#')
+            continue;
+        if (first == "version")
+        {
+            fields >> corpus.version;
+            continue;
+        }
+        CorpusCase c;
+        c.group = first;
+        std::string moves;
+        if (!(fields >> c.name) || !std::getline(fields, moves))
+        {
+            std::fprintf(stderr, "%s:%d: expected <group> <name> <scramble>\n", path.c_str(), lineNumber);
+            return false;
+        }
+        // Every move takes at least one character.
+        c.scramble.resize(moves.size());
+        int count = parseMoves(moves.c_str(), c.scramble.data(), c.scramble.size());
+        if (count < 0)
+        {
+            std::fprintf(stderr, "%s:%d: invalid scramble:%s\n", path.c_str(), lineNumber, moves.c_str());
+            return false;
+        }
+        c.scramble.resize(count);
+        c.depth = c.group.compare(0, 6, "depth-") == 0 ? std::atoi(c.group.c_str() + 6) : INT_MAX;
+        bool known = false;
+        for (const std::string &g : corpus.groups)
+            known = known || g == c.group;
+        if (!known)
+            corpus.groups.push_back(c.group);
+        corpus.cases.push_back(c);
+    }
+    if (corpus.version <= 0 || corpus.cases.empty())
+    {
+        std::fprintf(stderr, "%s: missing version line or positions\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+static double millisSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs one position, checks the solution and returns the median time per
+// solve over the batches.
+static double timeCase(const BenchSolver &solver, const CorpusCase &c, SolveRun &run)
+{
+    CubieCube cube;
+    cube.apply(c.scramble.data(), c.scramble.size());
+
+    auto start = std::chrono::steady_clock::now();
+    run = solver.solve(c, cube);
+    double first = millisSince(start);
+    if (run.solved)
+    {
+        CubieCube check = cube;
+        check.apply(run.solution.data(), run.solution.size());
+        run.solved = check.isSolved();
+    }
+
+    int repeats = first >= MIN_BATCH_MILLIS ? 1 : static_cast<int>(MIN_BATCH_MILLIS / std::max(first, 1e-4)) + 1;
+    std::vector<double> times(BATCHES);
+    for (double &time : times)
+    {
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+            solver.solve(c, cube);
+        time = millisSince(start) / repeats;
+    }
+    std::nth_element(times.begin(), times.begin() + BATCHES / 2, times.end());
+    return times[BATCHES / 2];
+}
+
+// Times a group's positions again and returns the sum of the times per solve.
+static double retimeGroup(const BenchSolver &solver, const Corpus &corpus, const std::string &group)
+{
+    double millis = 0;
+    for (const CorpusCase &c : corpus.cases)
+    {
+        if (c.group != group || !solver.handles(c))
+            continue;
+        SolveRun run;
+        millis += timeCase(solver, c, run);
+    }
+    return millis;
+}
+
+static std::vector<BenchSolver> allSolvers()
+{
+    std::vector<BenchSolver> solvers;
+    solvers.push_back({"ida*", [] {},
+                       [](const CorpusCase &c) { return c.depth <= IDA_STAR_MAX_DEPTH; },
+                       [](const CorpusCase &c, const CubieCube &) {
+                           RubiksCubeBitboard cube;
+                           cube.apply(c.scramble.data(), c.scramble.size());
+                           IDAstarSolver<RubiksCubeBitboard> solver(cube);
+                           std::vector<Move> solution = solver.solve(c.depth);
+                           return SolveRun{!solution.empty() || cube.isSolved(), solution,
+                                           static_cast<long long>(solver.getStats().totalNodes())};
+                       }});
+    solvers.push_back({"thistlethwaite", [] { ThistlethwaiteSolver::prepareTables(); },
+                       [](const CorpusCase &) { return true; },
+                       [](const CorpusCase &, const CubieCube &cube) {
+                           ThistlethwaiteSolver solver;
+                           ThistlethwaiteResult result = solver.solve(cube);
+                           return SolveRun{result.solved, result.solution, -1};
+                       }});
+    solvers.push_back({"cfop", [] { CfopSolver::prepareTables(); },
+                       [](const CorpusCase &) { return true; },
+                       [](const CorpusCase &, const CubieCube &cube) {
+                           CfopSolver solver;
+                           CfopResult result;
+                           bool solved = solver.solve(cube, result);
+                           return SolveRun{solved, result.solution, -1};
+                       }});
+    // Stopping at the first solution keeps the two-phase work independent of
+    // the clock, so its node counts are comparable between runs.
+    solvers.push_back({"two-phase", [] { TwoPhaseSolver::prepareTables(); },
+                       [](const CorpusCase &) { return true; },
+                       [](const CorpusCase &, const CubieCube &cube) {
+                           TwoPhaseSolver solver;
+                           TwoPhaseOptions options;
+                           options.targetLength = options.maxLength;
+                           TwoPhaseResult result = solver.solve(cube, options);
+                           return SolveRun{result.found, result.solution, static_cast<long long>(result.nodes)};
+                       }});
+    return solvers;
+}
+
+// The results file has one record per line, which is all readBaseline needs.
+static bool writeResults(const std::string &path, const Corpus &corpus, const std::vector<GroupRecord> &records)
+{
+    std::FILE *out = std::fopen(path.c_str(), "w");
+    if (!out)
+    {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return false;
+    }
+    std::fprintf(out, "{\n  \"corpus_version\": %d,\n  \"results\": [\n", corpus.version);
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const GroupRecord &r = records[i];
+        std::fprintf(out, "    {\"solver\": \"%s\", \"group\": \"%s\", \"cases\": %d, \"millis\": %.4f, ", r.solver.c_str(),
+                     r.group.c_str(), r.cases, r.millis);
+        if (r.nodes >= 0)
+            std::fprintf(out, "\"nodes\": %lld, ", r.nodes);
+        else
+            std::fprintf(out, "\"nodes\": null, ");
+        std::fprintf(out, "\"moves\": %lld, \"failures\": %d}%s\n", r.moves, r.failures, i + 1 < records.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+    return true;
+}
+
+static std::string stringField(const std::string &line, const std::string &key)
+{
+    size_t at = line.find("\"" + key + "\": \"");
+    if (at == std::string::npos)
+        return "";
+    at += key.size() + 5;
+    return line.substr(at, line.find('"', at) - at);
+}
+
+// Returns the number after "key": , or -1 if it is missing or null.
+static double numberField(const std::string &line, const std::string &key)
+{
+    size_t at = line.find("\"" + key + "\": ");
+    if (at == std::string::npos)
+        return -1;
+    const char *text = line.c_str() + at + key.size() + 4;
+    char *end;
+    double value = std::strtod(text, &end);
+    return end == text ? -1 : value;
+}
+
+static bool readBaseline(const std::string &path, int &version, std::vector<GroupRecord> &records)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.find("\"corpus_version\"") != std::string::npos)
+            version = static_cast<int>(numberField(line, "corpus_version"));
+        if (line.find("\"solver\"") == std::string::npos)
+            continue;
+        GroupRecord r;
+        r.solver = stringField(line, "solver");
+        r.group = stringField(line, "group");
+        r.cases = static_cast<int>(numberField(line, "cases"));
+        r.millis = numberField(line, "millis");
+        r.nodes = static_cast<long long>(numberField(line, "nodes"));
+        r.moves = static_cast<long long>(numberField(line, "moves"));
+        r.failures = static_cast<int>(numberField(line, "failures"));
+        records.push_back(r);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string corpusPath;
+    std::string baselinePath;
+    std::string outputPath;
+    double threshold = 25;
+    double minMillis = 10;
+    double noiseMillis = 1;
+    bool update = false;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--baseline" && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc)
+            threshold = std::atof(argv[++i]);
+        else if (arg == "--min-millis" && i + 1 < argc)
+            minMillis = std::atof(argv[++i]);
+        else if (arg == "--noise-millis" && i + 1 < argc)
+            noiseMillis = std::atof(argv[++i]);
+        else if (arg == "--output" && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (arg == "--update")
+            update = true;
+        else
+            corpusPath = arg;
+    }
+    if (corpusPath.empty() || (update && baselinePath.empty()))
+    {
+        std::fprintf(stderr,
+                     "Usage: %s CORPUS [--baseline FILE] [--threshold PCT] [--min-millis MS] [--noise-millis MS] "
+                     "[--output FILE] [--update]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    Corpus corpus;
+    if (!readCorpus(corpusPath, corpus))
+        return 2;
+    std::printf("Corpus %s: version %d, %zu positions in %zu groups\n\n", corpusPath.c_str(), corpus.version,
+                corpus.cases.size(), corpus.groups.size());
+
+    std::vector<GroupRecord> records;
+    int failures = 0;
+    std::vector<BenchSolver> solvers = allSolvers();
+    for (const BenchSolver &solver : solvers)
+    {
+        solver.prepare();
+        for (const std::string &group : corpus.groups)
+        {
+            GroupRecord record;
+            record.solver = solver.name;
+            record.group = group;
+            for (const CorpusCase &c : corpus.cases)
+            {
+                if (c.group != group || !solver.handles(c))
+                    continue;
+                SolveRun run;
+                record.millis += timeCase(solver, c, run);
+                record.cases++;
+                record.moves += run.solution.size();
+                if (run.nodes >= 0)
+                    record.nodes = std::max(record.nodes, 0LL) + run.nodes;
+                if (!run.solved)
+                {
+                    record.failures++;
+                    std::printf("FAILED: %s on %s\n", solver.name, c.name.c_str());
+                }
+            }
+            if (record.cases > 0)
+                records.push_back(record);
+            failures += record.failures;
+        }
+    }
+
+    if (!outputPath.empty() && !writeResults(outputPath, corpus, records))
+        return 2;
+    if (update)
+    {
+        if (!writeResults(baselinePath, corpus, records))
+            return 2;
+        std::printf("Baseline written to %s\n", baselinePath.c_str());
+    }
+
+    int baselineVersion = 0;
+    std::vector<GroupRecord> baseline;
+    bool compare = !update && !baselinePath.empty();
+    if (compare && !readBaseline(baselinePath, baselineVersion, baseline))
+    {
+        std::fprintf(stderr, "Cannot read baseline %s\n", baselinePath.c_str());
+        return 2;
+    }
+    if (compare && baselineVersion != corpus.version)
+    {
+        std::fprintf(stderr, "Baseline %s was recorded on corpus version %d, not %d; record a new one with --update\n",
+                     baselinePath.c_str(), baselineVersion, corpus.version);
+        return 2;
+    }
+
+    int slower = 0, moreWork = 0;
+    std::printf("%-15s %-9s %5s %12s %12s %8s %12s %9s\n", "solver", "group", "cases", "ms/group", "baseline ms", "change",
+                "nodes", "avg moves");
+    for (GroupRecord &r : records)
+    {
+        const GroupRecord *base = nullptr;
+        for (const GroupRecord &b : baseline)
+        {
+            if (b.solver == r.solver && b.group == r.group)
+                base = &b;
+        }
+        bool timed = base && base->millis >= minMillis;
+        auto looksSlower = [&] {
+            return timed && r.millis > base->millis * (1 + threshold / 100) && r.millis - base->millis > noiseMillis;
+        };
+        for (int retry = 0; retry < RETIMES && looksSlower(); retry++)
+        {
+            for (const BenchSolver &solver : solvers)
+            {
+                if (r.solver == solver.name)
+                    r.millis = std::min(r.millis, retimeGroup(solver, corpus, r.group));
+            }
+        }
+        std::printf("%-15s %-9s %5d %12.4f ", r.solver.c_str(), r.group.c_str(), r.cases, r.millis);
+        double change = base && base->millis > 0 ? (r.millis / base->millis - 1) * 100 : 0;
+        if (base && base->millis > 0)
+            std::printf("%12.4f %+7.1f%% ", base->millis, change);
+        else
+            std::printf("%12s %8s ", "-", "-");
+        if (r.nodes >= 0)
+            std::printf("%12lld ", r.nodes);
+        else
+            std::printf("%12s ", "-");
+        std::printf("%9.2f", double(r.moves) / r.cases);
+
+        bool isSlower = looksSlower();
+        bool isMoreWork = base && (r.nodes > base->nodes || r.moves > base->moves);
+        slower += isSlower;
+        moreWork += isMoreWork;
+        if (base && !timed)
+            std::printf("   (too short to time)");
+        if (isSlower)
+            std::printf("   SLOWER");
+        if (isMoreWork)
+            std::printf("   MORE WORK");
+        if (base && (base->nodes != r.nodes || base->moves != r.moves))
+            std::printf("   (baseline: %lld nodes, %.2f moves)", base->nodes, double(base->moves) / std::max(base->cases, 1));
+        std::printf("\n");
+    }
+
+    if (failures > 0)
+        std::printf("\n%d solves failed\n", failures);
+    if (moreWork > 0)
+        std::printf("\n%d solver/group results expand more nodes or return longer solutions than the baseline\n", moreWork);
+    if (slower > 0)
+        std::printf("\n%d solver/group results are more than %.0f%% and %.2f ms slower than the baseline "
+                    "(times compare only with a baseline recorded on this machine)\n",
+                    slower, threshold, noiseMillis);
+    return failures > 0 || moreWork > 0 || slower > 0 ? 1 : 0;
+}
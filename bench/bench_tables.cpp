@@ -0,0 +1,125 @@
+// Pattern database lookup throughput with and without huge pages. Builds the
+// corner table (42 MB), copies it into memory of each page kind and probes
+// it at random: once with independent lookups (throughput) and once with
+// each index depending on the previous result (latency, where TLB misses
+// show most). The table file is then mapped and loaded to show what the
+// file-backed paths obtain, and the loaded table is repacked with distances
+// mod 3 to show what halving it gains. Build and run with `make bench-tables`.
+//
+//   bench_tables [TABLE_FILE]
+#include "PatternDatabase.h"
+#include "Xoshiro256.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static double elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int nibbleAt(const uint8_t *entries, uint64_t i)
+{
+    return (entries[i >> 1] >> ((i & 1) << 2)) & 0xF;
+}
+
+static int residueAt(const uint8_t *entries, uint64_t i)
+{
+    return (entries[i >> 2] >> ((i & 3) << 1)) & 3;
+}
+
+// Independent and dependent lookup times in ns, plus a checksum so the
+// reads cannot be optimized away.
+template <int (*EntryAt)(const uint8_t *, uint64_t)>
+static uint64_t timeLookups(const uint8_t *entries, const std::vector<uint64_t> &indices, uint64_t count,
+                            double &independentNs, double &dependentNs)
+{
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sum = 0;
+    for (uint64_t i : indices)
+        sum += EntryAt(entries, i);
+    independentNs = elapsedNs(start) / indices.size();
+
+    // The next index depends on the value just read, so lookups cannot overlap.
+    start = std::chrono::steady_clock::now();
+    uint64_t chained = 0;
+    for (uint64_t i : indices)
+        chained = EntryAt(entries, (i + chained) % count);
+    dependentNs = elapsedNs(start) / indices.size();
+    return sum + chained;
+}
+
+static void benchLookups(const char *name, const TableMemory &memory, const std::vector<uint64_t> &indices, uint64_t count)
+{
+    const uint8_t *entries = memory.data() + sizeof(PatternDatabaseHeader);
+    double independentNs, dependentNs;
+    uint64_t checksum = reinterpret_cast<const PatternDatabaseHeader *>(memory.data())->encoding == PDB_ENCODING_MOD3
+                            ? timeLookups<residueAt>(entries, indices, count, independentNs, dependentNs)
+                            : timeLookups<nibbleAt>(entries, indices, count, independentNs, dependentNs);
+
+    std::printf("%-20s %-24s %5zu MB huge   %6.2f ns/lookup   %6.2f ns/dependent lookup   (%llu)\n", name,
+                pageKindName(memory.pageKind()), memory.hugeBytes() >> 20, independentNs, dependentNs,
+                static_cast<unsigned long long>(checksum));
+}
+
+// Fresh memory of the given policy holding a copy of the table, touched once
+// so page faults stay out of the timings. False if the memory cannot be had.
+static bool copyTable(const TableMemory &source, PagePolicy policy, TableMemory &copy)
+{
+    if (!copy.allocate(source.size(), policy))
+        return false;
+    std::memcpy(copy.data(), source.data(), source.size());
+    return true;
+}
+
+static void benchCopy(const char *name, const TableMemory &source, PagePolicy policy,
+                      const std::vector<uint64_t> &indices, uint64_t count)
+{
+    TableMemory copy;
+    if (copyTable(source, policy, copy))
+        benchLookups(name, copy, indices, count);
+    else
+        std::printf("%-20s cannot allocate %zu MB; skipped\n", name, source.size() >> 20);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = argc > 1 ? argv[1] : "corners.pdb";
+
+    PatternDatabase corners;
+    auto start = std::chrono::steady_clock::now();
+    corners.build(PatternKind::CORNERS);
+    std::printf("Built the corner table (%zu MB, max distance %d) in %.0f ms\n\n", corners.memory().size() >> 20,
+                corners.maxDistance(), elapsedNs(start) / 1e6);
+
+    uint64_t count = PatternDatabase::entryCount(PatternKind::CORNERS);
+    std::vector<uint64_t> indices(8 << 20);
+    Xoshiro256 random(2024);
+    for (uint64_t &i : indices)
+        i = random.next() % count;
+
+    benchCopy("anonymous, huge", corners.memory(), PagePolicy::HUGE_IF_AVAILABLE, indices, count);
+    benchCopy("anonymous, 4 KB", corners.memory(), PagePolicy::NORMAL_ONLY, indices, count);
+
+    if (!corners.save(path))
+    {
+        std::printf("Cannot write %s; skipping the file-backed runs\n", path);
+        return 0;
+    }
+    PatternDatabase loaded;
+    if (loaded.load(path))
+        benchLookups("file, loaded", loaded.memory(), indices, count);
+    PatternDatabase mapped;
+    if (mapped.map(path))
+    {
+        // Fault the mapping in before timing it.
+        volatile uint8_t sink = 0;
+        for (size_t i = 0; i < mapped.memory().size(); i += 4096)
+            sink = sink + mapped.memory().data()[i];
+        benchLookups("file, mapped", mapped.memory(), indices, count);
+    }
+    if (loaded.isLoaded() && loaded.encodeMod3())
+        benchLookups("mod 3, huge", loaded.memory(), indices, count);
+    return 0;
+}
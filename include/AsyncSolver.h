@@ -0,0 +1,82 @@
+#ifndef ASYNC_SOLVER_H
+#define ASYNC_SOLVER_H
+
+#include "MultiAxisSolver.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// A two-phase solve running on its own thread. The best solution so far can
+// be read at any time; it only ever gets shorter. Destroying the handle
+// cancels the search and waits for the thread.
+class SolveHandle
+{
+public:
+    enum class Status
+    {
+        RUNNING,
+        EXHAUSTED,      // the search finished on its own
+        TARGET_REACHED,
+        DEADLINE,
+        CANCELLED,
+        INVALID_CUBE
+    };
+
+    SolveHandle() = default;
+    SolveHandle(SolveHandle &&other) = default;
+    SolveHandle &operator=(SolveHandle &&other);
+    ~SolveHandle();
+
+    // Asks the search to stop; it does so well within a millisecond.
+    void cancel();
+
+    // Blocks until the search has stopped. waitUntil gives up at `until` and
+    // returns whether the search has stopped.
+    void wait() const;
+    bool waitUntil(std::chrono::steady_clock::time_point until) const;
+
+    Status status() const;
+    bool hasSolution() const;
+    std::vector<Move> bestSolution() const;
+    // Number of successively shorter solutions published so far.
+    int improvements() const;
+
+private:
+    friend class AsyncSolver;
+
+    struct Shared
+    {
+        mutable std::mutex mutex;
+        mutable std::condition_variable changed;
+        std::atomic<bool> cancel{false};
+        Status status = Status::RUNNING;
+        std::vector<Move> best;
+        bool found = false;
+        int improvements = 0;
+    };
+
+    std::shared_ptr<Shared> shared;
+    std::thread worker;
+};
+
+// Starts deadline-bounded solves. Each request gets its own thread and
+// solver; the tables are shared.
+class AsyncSolver
+{
+public:
+    // `targetLength` stops a search as soon as a solution this short is found.
+    // With `variants` above 1 each request searches that many views of the
+    // cube in parallel (see MultiAxisSolver).
+    explicit AsyncSolver(int maxLength = 30, int targetLength = 0, int variants = 1);
+
+    SolveHandle solve(const CubieCube &cube, std::chrono::steady_clock::time_point deadline);
+    SolveHandle solve(const RubiksCube &cube, std::chrono::steady_clock::time_point deadline);
+
+private:
+    int maxLength;
+    int targetLength;
+    int variants;
+};
+
+#endif // ASYNC_SOLVER_H
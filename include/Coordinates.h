@@ -0,0 +1,48 @@
+#ifndef COORDINATES_H
+#define COORDINATES_H
+
+#include "CubieCube.h"
+
+// Integer coordinates for parts of a cubie state, as used by table-driven
+// solvers. Each get function maps the relevant part of the state onto
+// 0..N-1, with 0 for the solved cube; each set function overwrites just that
+// part of the state with some arrangement having the given coordinate.
+
+constexpr int NUM_TWIST = 2187;        // 3^7 corner twists
+constexpr int NUM_FLIP = 2048;         // 2^11 edge flips
+constexpr int NUM_SLICE = 495;         // C(12,4) positions of the E-slice edges (FR FL BL BR)
+constexpr int NUM_CORNER_PERM = 40320; // 8! corner permutations
+constexpr int NUM_UD_EDGE_PERM = 40320;// 8! permutations of the U and D edges, slice edges in the slice
+constexpr int NUM_SLICE_PERM = 24;     // 4! permutations of the slice edges, within the slice
+
+// Binomial coefficient C(n, k), 0 when k > n.
+int binomial(int n, int k);
+
+// Lehmer rank of a permutation of 0..n-1, and its inverse.
+int permutationRank(const uint8_t *perm, int n);
+void permutationUnrank(int rank, uint8_t *perm, int n);
+
+int twistCoord(const CubieCube &cube);
+void setTwistCoord(CubieCube &cube, int twist);
+
+int flipCoord(const CubieCube &cube);
+void setFlipCoord(CubieCube &cube, int flip);
+
+// Which 4 of the 12 edge slots hold slice edges; which slice edge is where is
+// ignored.
+int sliceCoord(const CubieCube &cube);
+void setSliceCoord(CubieCube &cube, int slice);
+
+int cornerPermCoord(const CubieCube &cube);
+void setCornerPermCoord(CubieCube &cube, int perm);
+
+// The two coordinates below are only meaningful while every slice edge is in
+// the slice (the cube is in the <U, D, L2, R2, F2, B2> group up to twists
+// and flips). The setters place all edges accordingly.
+int udEdgePermCoord(const CubieCube &cube);
+void setUdEdgePermCoord(CubieCube &cube, int perm);
+
+int slicePermCoord(const CubieCube &cube);
+void setSlicePermCoord(CubieCube &cube, int perm);
+
+#endif // COORDINATES_H
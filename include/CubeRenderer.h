@@ -0,0 +1,60 @@
+#ifndef CUBE_RENDERER_H
+#define CUBE_RENDERER_H
+
+#include "CubieCube.h"
+#include "RubiksCube.h"
+#include <ostream>
+#include <string>
+
+// Text layouts for a cube state, all ending in a newline.
+enum class RenderFormat
+{
+    NET,      // the unfolded cube print() shows, 12 lines; nets are separated by a blank line
+    FACELETS, // the 54-character facelet string (see Facelets.h)
+    COMPACT   // the six faces in U L F R B D order as color letters, e.g. "WWWWWWWWW GGGGGGGGG ..."
+};
+
+// Formats cube states into a caller-supplied string and writes them out in
+// one go. Each state costs one getStickers() call and a pass over a table,
+// so logging thousands of states is bounded by a single write per batch
+// rather than a flush per line.
+//
+//     std::string text;
+//     CubeRenderer renderer(text, RenderFormat::COMPACT);
+//     for (const RubiksCube1DArray &cube : cubes)
+//         renderer.add(cube);
+//     renderer.flush(std::cout);
+class CubeRenderer
+{
+public:
+    explicit CubeRenderer(std::string &buffer, RenderFormat format = RenderFormat::NET);
+
+    // Characters one state adds (a NET also adds one for the separating blank line).
+    static size_t renderedSize(RenderFormat format);
+
+    // Appends one state to the buffer.
+    void add(const RubiksCube &cube);
+    void add(const CubieCube &cube);
+    // 54 sticker colors indexed face * 9 + row * 3 + col.
+    void add(const RubiksCube::Color *stickers);
+
+    // Reserves room for `count` more states, so a batch grows the buffer once.
+    void reserve(size_t count);
+
+    // Number of states added since the last flush.
+    size_t count() const
+    {
+        return added;
+    }
+
+    // Writes the buffer with a single write() and flush of `out`, then clears
+    // it. Returns false if the stream failed.
+    bool flush(std::ostream &out);
+
+private:
+    std::string &buffer;
+    RenderFormat format;
+    size_t added = 0;
+};
+
+#endif // CUBE_RENDERER_H
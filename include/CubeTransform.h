@@ -0,0 +1,48 @@
+#ifndef CUBE_TRANSFORM_H
+#define CUBE_TRANSFORM_H
+
+#include "RubiksCube.h"
+#include <cstdint>
+
+// A whole move sequence collapsed into one permutation of the 54 sticker
+// positions (face * 9 + row * 3 + col). Applying it costs one pass over the
+// stickers no matter how many moves it was built from.
+class CubeTransform
+{
+private:
+    // source[i] is the position whose sticker ends up at position i.
+    uint8_t source[RubiksCube::NUM_STICKERS];
+
+public:
+    // Constructor: the identity transform.
+    CubeTransform();
+
+    static CubeTransform fromMove(Move m);
+    static CubeTransform fromMoves(const Move *moves, size_t count);
+
+    // The transform equal to applying this one and then `next`.
+    CubeTransform then(const CubeTransform &next) const;
+
+    CubeTransform inverse() const;
+
+    // This transform applied n times; negative n repeats the inverse.
+    CubeTransform power(int n) const;
+
+    // Applies the transform to 54 stickers in the shared layout.
+    void applyTo(RubiksCube::Color *stickers) const;
+
+    // Applies the transform to any cube model.
+    void applyTo(RubiksCube &cube) const;
+
+    bool isIdentity() const;
+
+    bool operator==(const CubeTransform &other) const;
+
+    // The source index of every position, for kernels that permute stickers directly.
+    const uint8_t *data() const
+    {
+        return source;
+    }
+};
+
+#endif // CUBE_TRANSFORM_H
@@ -0,0 +1,85 @@
+#ifndef CUBIE_CUBE_H
+#define CUBIE_CUBE_H
+
+#include "RubiksCube.h"
+#include <cstdint>
+
+// The cube as 8 corner and 12 edge pieces: which piece sits in each slot and
+// how it is twisted or flipped. This is the representation the solvers and
+// state encoders work on; the sticker models convert to and from it.
+struct CubieCube
+{
+    enum Corner
+    {
+        URF,
+        UFL,
+        ULB,
+        UBR,
+        DFR,
+        DLF,
+        DBL,
+        DRB
+    };
+
+    enum Edge
+    {
+        UR,
+        UF,
+        UL,
+        UB,
+        DR,
+        DF,
+        DL,
+        DB,
+        FR,
+        FL,
+        BL,
+        BR
+    };
+
+    // Sticker indices (face * 9 + row * 3 + col) of each corner slot, starting
+    // with its U or D sticker and going clockwise.
+    static const int CORNER_FACELETS[8][3];
+    // Sticker indices of each edge slot, U/D or F/B sticker first.
+    static const int EDGE_FACELETS[12][2];
+
+    uint8_t cp[8]; // corner permutation: the corner in each slot
+    uint8_t co[8]; // corner orientation: 0, 1 or 2 clockwise twists
+    uint8_t ep[12];
+    uint8_t eo[12];
+
+    // Constructor: the solved cube.
+    CubieCube();
+
+    // The cubie form of a single move.
+    static const CubieCube &moveCube(Move m);
+
+    // Applies `other` after this state (this = this * other).
+    void multiply(const CubieCube &other);
+
+    void move(Move m);
+    void apply(const Move *moves, size_t count);
+
+    CubieCube inverse() const;
+
+    bool isSolved() const;
+    bool operator==(const CubieCube &other) const;
+
+    // Parity (0 even, 1 odd) of the corner and edge permutations.
+    int cornerParity() const;
+    int edgeParity() const;
+
+    // Writes the 54 sticker colors, with each face's center in its solved color.
+    void toStickers(RubiksCube::Color *stickers) const;
+
+    // Identifies every piece from its sticker colors. Returns false if some
+    // slot holds a color combination that is not a real piece; the result does
+    // not check that the pieces are distinct or that the state is solvable.
+    bool fromStickers(const RubiksCube::Color *stickers);
+
+    // Conversions from and to any model.
+    bool fromCube(const RubiksCube &cube);
+    void toCube(RubiksCube &cube) const;
+};
+
+#endif // CUBIE_CUBE_H
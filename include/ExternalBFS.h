@@ -0,0 +1,66 @@
+#ifndef EXTERNAL_BFS_H
+#define EXTERNAL_BFS_H
+
+#include "PackedState.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Statistics for one completed BFS layer.
+struct BfsLayer
+{
+    int depth;
+    uint64_t count;     // positions at exactly this distance
+    uint64_t generated; // children produced while expanding the previous layer
+    double seconds;
+
+    double statesPerSecond() const { return seconds > 0 ? generated / seconds : 0; }
+};
+
+// Breadth-first search from the solved cube whose layers live on disk, for
+// depths where a frontier no longer fits in memory.
+//
+// Each layer is a state file (see StateFile.h) of sorted, distinct packed
+// states. To build layer d + 1, layer d is streamed and expanded; children are
+// collected in a buffer of bounded size, which is sorted, deduplicated and
+// written out as a run whenever it fills. The runs are then merged, and
+// because a child of layer d can only lie in layers d - 1, d or d + 1, the
+// merge drops every state found in layers d - 1 and d. All file access is
+// sequential.
+//
+// After each layer a manifest is rewritten in the directory; run() on the
+// same directory resumes after the last completed layer.
+class ExternalBFS
+{
+public:
+    // `memoryStates` bounds the run buffer (16 bytes per state).
+    explicit ExternalBFS(const std::string &directory, size_t memoryStates = 1 << 24);
+
+    // Computes layers up to `maxDepth`, skipping those already completed.
+    // `onLayer` is called after each layer, including ones loaded from the
+    // manifest. Returns false on an I/O error.
+    bool run(int maxDepth, const std::function<void(const BfsLayer &)> &onLayer = nullptr);
+
+    const std::vector<BfsLayer> &layers() const { return completed; }
+
+    // Old layers are deleted once no longer needed unless this is set.
+    void setKeepLayers(bool keep) { keepLayers = keep; }
+
+private:
+    std::string layerPath(int depth) const;
+    std::string runPath(int depth, size_t run) const;
+    std::string manifestPath() const;
+
+    bool loadManifest();
+    bool saveManifest() const;
+    bool writeRun(std::vector<PackedState> &buffer, int depth, size_t run);
+    bool buildLayer(int depth, BfsLayer &layer);
+
+    std::string directory;
+    size_t memoryStates;
+    bool keepLayers = false;
+    std::vector<BfsLayer> completed;
+};
+
+#endif // EXTERNAL_BFS_H
@@ -0,0 +1,44 @@
+#ifndef FACELETS_H
+#define FACELETS_H
+
+#include "CubieCube.h"
+#include <string>
+
+// Import and export of the standard 54-character facelet string used by most
+// cube tools: the faces in U R F D L B order, each written row by row as seen
+// in the usual net (U and D with the F side nearest row 2 and row 0
+// respectively). Each character names the face whose center has that color,
+// e.g. "UUUUUUUUURRRRRRRRRFFFFFFFFFDDDDDDDDDLLLLLLLLLBBBBBBBBB" is solved.
+// Any six distinct characters are accepted; the centers define which is which.
+
+enum class FaceletError
+{
+    NONE,
+    WRONG_LENGTH,      // not exactly 54 characters
+    BAD_CENTERS,       // two centers share a character
+    UNKNOWN_COLOR,     // a character that is no center's
+    WRONG_COLOR_COUNT, // some color does not appear exactly 9 times
+    INVALID_PIECE,     // a corner or edge whose colors are no real piece
+    DUPLICATE_PIECE,   // the same corner or edge appears twice
+    TWISTED_CORNER,    // corner twists do not sum to 0 mod 3
+    FLIPPED_EDGE,      // an odd number of flipped edges
+    PARITY             // corner and edge permutation parities differ
+};
+
+const char *faceletErrorName(FaceletError error);
+
+// Checks that a cubie state can be reached by turning faces.
+FaceletError validateCubie(const CubieCube &cube);
+
+// Parses and validates a facelet string. `cube` is left unchanged on error.
+FaceletError parseFacelets(const std::string &facelets, CubieCube &cube);
+FaceletError parseFacelets(const std::string &facelets, RubiksCube &cube);
+
+// Formats a state with the face letters U R F D L B.
+std::string toFacelets(const CubieCube &cube);
+// Any model; the stickers are written as they are, without validation.
+std::string toFacelets(const RubiksCube &cube);
+// Writes the 54 characters for stickers laid out face * 9 + row * 3 + col.
+void writeFacelets(const RubiksCube::Color *stickers, char *out);
+
+#endif // FACELETS_H
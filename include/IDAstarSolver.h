@@ -0,0 +1,176 @@
+#ifndef IDA_STAR_SOLVER_H
+#define IDA_STAR_SOLVER_H
+
+#include "MoveStack.h"
+#include "Profiler.h"
+#include "RubiksCube.h"
+#include "SearchStats.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <vector>
+
+// Admissible heuristic for any sticker model: a single move relocates at most
+// 20 non-center stickers, so at least ceil(misplaced / 20) moves remain.
+struct MisplacedStickerHeuristic
+{
+    template <typename T>
+    int operator()(const T &cube, SearchStats &) const
+    {
+        int misplaced = 0;
+        for (int face = 0; face < 6; face++)
+        {
+            for (unsigned int row = 0; row < 3; row++)
+            {
+                for (unsigned int col = 0; col < 3; col++)
+                {
+                    if (cube.getColor(static_cast<RubiksCube::Face>(face), row, col) != static_cast<RubiksCube::Color>(face))
+                    {
+                        misplaced++;
+                    }
+                }
+            }
+        }
+        return (misplaced + 19) / 20;
+    }
+};
+
+// Heuristics that follow the search path (see PatternDatabaseHeuristic) are
+// also given the depth of the node; they see every node after its parent.
+// Others are called with the cube alone.
+template <typename H, typename T>
+auto evaluateHeuristic(H &heuristic, const T &cube, int depth, SearchStats &stats, int)
+    -> decltype(heuristic(cube, depth, stats))
+{
+    return heuristic(cube, depth, stats);
+}
+
+template <typename H, typename T>
+int evaluateHeuristic(H &heuristic, const T &cube, int, SearchStats &stats, long)
+{
+    return heuristic(cube, stats);
+}
+
+// Iterative-deepening A* over any RubiksCube model T.
+// H is called as h(cube, stats), or h(cube, depth, stats) where it takes
+// one, and must never overestimate the distance to solved.
+// The search turns a single working copy of the cube forwards and back (see
+// MoveStack) rather than copying it for every node.
+template <typename T, typename H = MisplacedStickerHeuristic>
+class IDAstarSolver
+{
+private:
+    T cube;
+    H heuristic;
+    T work;
+    MoveStack<T> path;
+    SearchStats stats;
+
+    static constexpr int FOUND = -1;
+
+    // Returns FOUND once the cube is solved, leaving the solution on `path`;
+    // otherwise the smallest f-value that exceeded the bound.
+    int search(int g, int bound)
+    {
+        RUBIKS_PROFILE_COUNT("IDAstar::nodes", 1);
+        int h;
+        {
+            RUBIKS_PROFILE_SCOPE("IDAstar::heuristic");
+            h = evaluateHeuristic(heuristic, work, g, stats, 0);
+        }
+        RUBIKS_STATS(stats.nodesPerDepth[std::min(g, SearchStats::MAX_DEPTH - 1)]++);
+        RUBIKS_STATS(stats.heuristicHistogram[std::min(h, SearchStats::MAX_HEURISTIC - 1)]++);
+
+        int f = g + h;
+        if (f > bound)
+        {
+            RUBIKS_STATS(stats.prunedByBound++);
+            return f;
+        }
+        if (work.isSolved())
+        {
+            return FOUND;
+        }
+
+#if RUBIKS_STATS_ENABLED
+        for (int face = 0; face < 6; face++)
+        {
+            if (!isCanonicalAfter(face, path.lastFace()))
+                stats.prunedByMoveRules += 3;
+        }
+#endif
+        int minExceeded = INT_MAX;
+        bool found = path.expand([&] {
+            int t = search(g + 1, bound);
+            minExceeded = std::min(minExceeded, t);
+            return t == FOUND;
+        });
+        return found ? FOUND : minExceeded;
+    }
+
+public:
+    explicit IDAstarSolver(const T &cube, H heuristic = H()) : cube(cube), heuristic(heuristic), work(cube), path(work) {}
+
+    // `path` refers to this solver's own working cube.
+    IDAstarSolver(const IDAstarSolver &) = delete;
+    IDAstarSolver &operator=(const IDAstarSolver &) = delete;
+
+    // Returns an optimal solution, or an empty vector if none exists within
+    // maxDepth moves (at most MoveStack's capacity).
+    std::vector<Move> solve(int maxDepth = 20)
+    {
+        stats.reset();
+        path.clear();
+        maxDepth = std::min(maxDepth, MoveStack<T>::CAPACITY);
+#if RUBIKS_STATS_ENABLED
+        auto solveStart = std::chrono::steady_clock::now();
+#endif
+
+        std::vector<Move> moves;
+        int bound = evaluateHeuristic(heuristic, cube, 0, stats, 0);
+        while (bound <= maxDepth)
+        {
+#if RUBIKS_STATS_ENABLED
+            auto iterationStart = std::chrono::steady_clock::now();
+            uint64_t nodesBefore = stats.totalNodes();
+#endif
+            int t;
+            {
+                RUBIKS_PROFILE_SCOPE("IDAstar::iteration");
+                t = search(0, bound);
+            }
+#if RUBIKS_STATS_ENABLED
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - iterationStart;
+            stats.iterationBounds.push_back(bound);
+            stats.iterationNodes.push_back(stats.totalNodes() - nodesBefore);
+            stats.iterationMillis.push_back(elapsed.count());
+#endif
+            if (t == FOUND)
+            {
+                moves.assign(path.moves(), path.moves() + path.size());
+                path.clear();
+                break;
+            }
+            if (t == INT_MAX)
+            {
+                break;
+            }
+            bound = t;
+        }
+
+#if RUBIKS_STATS_ENABLED
+        std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - solveStart;
+        stats.totalMillis = total.count();
+        stats.solutionLength = (moves.empty() && !cube.isSolved()) ? -1 : static_cast<int>(moves.size());
+#endif
+        return moves;
+    }
+
+    // Statistics of the most recent solve() call.
+    const SearchStats &getStats() const
+    {
+        return stats;
+    }
+};
+
+#endif // IDA_STAR_SOLVER_H
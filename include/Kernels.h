@@ -0,0 +1,50 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "Move.h"
+#include <cstddef>
+#include <cstdint>
+
+// Batch kernels over cube states stored as 64-byte sticker rows: bytes 0-53
+// hold the sticker colors in the face * 9 + row * 3 + col layout, bytes
+// 54-63 are padding. Several ISA-specific versions of each kernel are
+// compiled into the binary and the best one for the running CPU is chosen
+// once at startup, so one build runs well on every x86-64 machine.
+constexpr size_t KERNEL_ROW_BYTES = 64;
+
+struct KernelTable
+{
+    // Name of the instruction set the kernels were written for.
+    const char *name;
+
+    // Per-row shuffle control prepared from a 64-entry source table
+    // (out[i] = in[source[i]]); `control` must hold KERNEL_CONTROL_BYTES.
+    void (*preparePermute)(const uint8_t *source, uint8_t *control);
+
+    // Applies a prepared permutation to `count` rows in place.
+    void (*permuteRows)(const uint8_t *control, uint8_t *rows, size_t count);
+
+    // Applies `length` moves to one row, keeping it in registers between
+    // them. `controls` holds the prepared permutation of each of the 18
+    // moves, KERNEL_CONTROL_BYTES apart. Null where turning the stickers
+    // one by one is as fast (SSSE3's 16 shuffles a move are not faster).
+    void (*permuteSequence)(const uint8_t *controls, const Move *moves, size_t length, uint8_t *row);
+
+    // Number of rows equal to the 64-byte `target` row.
+    size_t (*countEqualRows)(const uint8_t *rows, size_t count, const uint8_t *target);
+};
+
+// Enough for the widest variant's precomputed shuffle masks.
+constexpr size_t KERNEL_CONTROL_BYTES = 512;
+
+// The kernels selected for this CPU. Setting RUBIKS_KERNEL to one of the
+// names below forces a lower variant, e.g. for comparison benchmarks.
+const KernelTable &activeKernels();
+
+// All variants compiled into this binary, best first, and whether the
+// running CPU supports each one.
+size_t availableKernelCount();
+const KernelTable &kernelVariant(size_t index);
+bool kernelSupported(size_t index);
+
+#endif // KERNELS_H
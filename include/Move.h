@@ -0,0 +1,100 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The 18 face turns, one byte each. The numbering matches RubiksCube::getMove:
+// move / 3 is the face (U, L, F, R, B, D order) and move % 3 is the turn
+// (clockwise, counter-clockwise, half).
+enum class Move : uint8_t
+{
+    U,
+    U_PRIME,
+    U2,
+    L,
+    L_PRIME,
+    L2,
+    F,
+    F_PRIME,
+    F2,
+    R,
+    R_PRIME,
+    R2,
+    B,
+    B_PRIME,
+    B2,
+    D,
+    D_PRIME,
+    D2
+};
+
+constexpr int NUM_MOVES = 18;
+
+// Face index (0-5) of a move, matching RubiksCube::Face.
+inline int moveFace(Move move)
+{
+    return static_cast<int>(move) / 3;
+}
+
+// Number of clockwise quarter turns a move performs (1, 3 or 2).
+inline int moveQuarterTurns(Move move)
+{
+    static const int turns[3] = {1, 3, 2};
+    return turns[static_cast<int>(move) % 3];
+}
+
+// Builds the move turning `face` clockwise by `quarterTurns` (1-3) quarter turns.
+inline Move makeMove(int face, int quarterTurns)
+{
+    static const int offset[4] = {0, 0, 2, 1};
+    return static_cast<Move>(face * 3 + offset[quarterTurns & 3]);
+}
+
+// The move that undoes `move`: same face, opposite direction (half turns are
+// their own inverse).
+inline Move inverse(Move move)
+{
+    return makeMove(moveFace(move), 4 - moveQuarterTurns(move));
+}
+
+// Index of the face opposite to `face`.
+inline int oppositeFace(int face)
+{
+    static const int opposite[6] = {5, 3, 4, 1, 2, 0};
+    return opposite[face];
+}
+
+// Whether a turn of `face` may follow a turn of `lastFace` (-1 for none) in a
+// canonical sequence: never the same face twice, and two opposite faces, which
+// commute, only in U L F before D R B order.
+inline bool isCanonicalAfter(int face, int lastFace)
+{
+    return lastFace < 0 || (face != lastFace && !(oppositeFace(face) == lastFace && face < lastFace));
+}
+
+// Standard notation for a move, e.g. "R'".
+const char *moveName(Move move);
+
+// Parses notation such as "R U R' U2" into `out`. Faces are U L F R B D,
+// optionally followed by ', 2 or 2'; whitespace between moves is optional.
+// Returns the number of moves written, or -1 on a syntax error or if more
+// than `capacity` moves are given.
+int parseMoves(const char *text, Move *out, size_t capacity);
+
+// Cancels and merges redundant turns in place (R R -> R2, R R' -> nothing),
+// also across turns of the opposite face, which commute (R L R -> L R2).
+// Pairs of opposite-face turns are left in U L F before D R B order.
+// Returns the new length.
+size_t simplifyMoves(Move *moves, size_t count);
+
+// Parses and simplifies an algorithm into `moves`. Returns false on a syntax
+// error; a valid algorithm may still simplify to no moves at all (R R').
+bool parseAlgorithm(const std::string &text, std::vector<Move> &moves);
+
+// Formats moves in standard notation, separated by spaces.
+std::string formatMoves(const Move *moves, size_t count);
+
+#endif // MOVE_H
@@ -0,0 +1,86 @@
+#ifndef MOVE_STACK_H
+#define MOVE_STACK_H
+
+#include "Move.h"
+
+// The path of a depth-first search over a single working state. Each move is
+// applied to the state in place and undone with its inverse on the way back,
+// so a node costs two moves instead of a copy of the cube, nothing is
+// allocated, and all the search touches is the state and this fixed array.
+//
+// T is any type with apply(const Move *, size_t): the sticker models and
+// CubieCube.
+template <typename T, int Capacity = 32>
+class MoveStack
+{
+public:
+    static constexpr int CAPACITY = Capacity;
+
+    explicit MoveStack(T &state) : state(state) {}
+
+    void push(Move m)
+    {
+        state.apply(&m, 1);
+        path[count++] = m;
+    }
+
+    void pop()
+    {
+        Move undo = inverse(path[--count]);
+        state.apply(&undo, 1);
+    }
+
+    // Tries every move that is canonical after the current path: applies it,
+    // calls visit() and undoes it again. If visit() returns true the search
+    // stops there, with that move left on the stack, and this returns true.
+    template <typename Visit>
+    bool expand(Visit visit)
+    {
+        if (count == Capacity)
+            return false;
+        int last = lastFace();
+        for (int face = 0; face < 6; face++)
+        {
+            if (!isCanonicalAfter(face, last))
+                continue;
+            for (int turn = 0; turn < 3; turn++)
+            {
+                push(static_cast<Move>(face * 3 + turn));
+                if (visit())
+                    return true;
+                pop();
+            }
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        while (count > 0)
+            pop();
+    }
+
+    // Face of the last move, or -1 on an empty path.
+    int lastFace() const
+    {
+        return count > 0 ? moveFace(path[count - 1]) : -1;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    const Move *moves() const
+    {
+        return path;
+    }
+
+    T &state;
+
+private:
+    Move path[Capacity];
+    int count = 0;
+};
+
+#endif // MOVE_STACK_H
@@ -0,0 +1,33 @@
+#ifndef MULTI_AXIS_SOLVER_H
+#define MULTI_AXIS_SOLVER_H
+
+#include "TwoPhaseSolver.h"
+
+// Runs the two-phase search on up to six views of the same cube at once:
+// the cube turned so each of its three axes plays the U-D axis, each both as
+// given and inverted. A view can be much easier for phase 1 than the
+// original, so the first good solution usually comes sooner and the final
+// one is shorter. The searches run on their own threads and share one best
+// length, so each prunes against what the others have found; the winning
+// solution is mapped back to the cube as given.
+class MultiAxisSolver
+{
+public:
+    static constexpr int MAX_VARIANTS = 6;
+
+    // `variants` (1-6) views are searched, in the order: U-D axis, its
+    // inverse, R-L axis, its inverse, F-B axis, its inverse. With one, the
+    // search runs on the calling thread.
+    explicit MultiAxisSolver(int variants = MAX_VARIANTS);
+
+    // The options apply to every search. onSolution is called with each
+    // solution shorter than all earlier ones, already mapped back, from
+    // whichever thread found it (never two at once). The result's node count
+    // is the sum over all searches.
+    TwoPhaseResult solve(const CubieCube &cube, const TwoPhaseOptions &options = TwoPhaseOptions()) const;
+
+private:
+    int variants;
+};
+
+#endif // MULTI_AXIS_SOLVER_H
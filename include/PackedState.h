@@ -0,0 +1,56 @@
+#ifndef PACKED_STATE_H
+#define PACKED_STATE_H
+
+#include "CubieCube.h"
+#include <cstdint>
+#include <functional>
+
+// A complete cube state in 16 bytes (100 bits used):
+//   lo: corner permutation (8 x 3 bits), corner twists (8 x 2 bits) at bit 24,
+//       edge flips (12 x 1 bit) at bit 40
+//   hi: edge permutation (12 x 4 bits)
+// Equal states always pack to equal bytes, so packed states can be compared,
+// sorted and hashed directly.
+struct PackedState
+{
+    uint64_t lo;
+    uint64_t hi;
+
+    bool operator==(const PackedState &other) const
+    {
+        return lo == other.lo && hi == other.hi;
+    }
+
+    bool operator!=(const PackedState &other) const
+    {
+        return !(*this == other);
+    }
+
+    bool operator<(const PackedState &other) const
+    {
+        return hi != other.hi ? hi < other.hi : lo < other.lo;
+    }
+};
+
+static_assert(sizeof(PackedState) == 16, "PackedState must stay 16 bytes");
+
+PackedState packState(const CubieCube &cube);
+CubieCube unpackState(const PackedState &state);
+
+// Converters for any model. packCube fails if the model's stickers do not
+// form real pieces.
+bool packCube(const RubiksCube &cube, PackedState &state);
+void unpackCube(const PackedState &state, RubiksCube &cube);
+
+struct PackedStateHash
+{
+    size_t operator()(const PackedState &state) const
+    {
+        uint64_t h = state.lo * 0x9E3779B97F4A7C15ULL ^ state.hi;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+#endif // PACKED_STATE_H
@@ -0,0 +1,235 @@
+#ifndef PATTERN_DATABASE_H
+#define PATTERN_DATABASE_H
+
+#include "CubieCube.h"
+#include "MoveStack.h"
+#include "SearchStats.h"
+#include "TableMemory.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Pattern databases: the exact number of moves needed to solve one group of
+// pieces, ignoring all others, for every arrangement of that group. Each is
+// a lower bound on the distance of the whole cube, which is what makes them
+// useful as IDA* heuristics.
+enum class PatternKind : uint32_t
+{
+    CORNERS,     // all 8 corners: 8! * 3^7 = 88,179,840 entries (42 MB)
+    EDGES_FIRST, // edges UR UF UL UB DR DF: 12!/6! * 2^6 = 42,577,920 entries (20 MB)
+    EDGES_LAST   // edges DL DB FR FL BL BR, same size
+};
+
+constexpr int NUM_PATTERN_KINDS = 3;
+
+const char *patternKindName(PatternKind kind);
+// Accepts the names patternKindName() returns.
+bool parsePatternKind(const std::string &name, PatternKind &kind);
+
+// On-disk layout: this header followed by the entries in one of two
+// encodings:
+//   PDB_ENCODING_NIBBLES  two 4-bit distances per byte (entry i in the low
+//                         nibble of byte i / 2 when i is even).
+//   PDB_ENCODING_MOD3     four 2-bit distances mod 3 per byte (entry i in
+//                         bits 2 * (i % 4) of byte i / 4), half the size. A
+//                         move changes a distance by at most one, so knowing
+//                         a neighbor's distance is enough to recover it.
+// The file is the in-memory image, so it can be mapped and used directly.
+struct PatternDatabaseHeader
+{
+    char magic[8]; // "RUBIKPDB"
+    uint32_t version;
+    uint32_t kind;
+    uint32_t encoding;
+    uint32_t maxDistance;
+    uint64_t entryCount;
+};
+
+static_assert(sizeof(PatternDatabaseHeader) == 32, "PatternDatabaseHeader must stay 32 bytes");
+
+constexpr uint32_t PATTERN_DATABASE_VERSION = 1;
+constexpr uint32_t PDB_ENCODING_NIBBLES = 0;
+constexpr uint32_t PDB_ENCODING_MOD3 = 1;
+
+// "nibbles" or "mod3".
+const char *pdbEncodingName(uint32_t encoding);
+bool parsePdbEncoding(const std::string &name, uint32_t &encoding);
+
+// A checkpoint written or resumed during a build.
+struct PatternCheckpointEvent
+{
+    bool resumed;      // true for the checkpoint a build started from, false for one it wrote
+    bool ok;           // false if writing failed; the build carries on
+    int depth;         // the level being built
+    uint64_t position; // entries of that level's scan already done
+    size_t bytes;
+    double seconds;    // time spent writing or reading it
+};
+
+struct PatternBuildOptions
+{
+    PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE;
+
+    // The build itself (and its checkpoints) always works on nibbles; a
+    // PDB_ENCODING_MOD3 table is packed from them at the end, which briefly
+    // needs memory for both.
+    uint32_t encoding = PDB_ENCODING_NIBBLES;
+
+    // If set, progress is saved here every checkpointSeconds: the level
+    // being built, how far its scan has got and the partly filled table
+    // (which is also the frontier: the entries at the current depth). Each
+    // checkpoint goes to a temporary file that is renamed over the previous
+    // one, so a crash leaves either the old or the new checkpoint. A build
+    // that finds a checkpoint for the same table resumes from it and
+    // produces the same table as an uninterrupted one; the file is removed
+    // when the build completes.
+    std::string checkpointPath;
+    double checkpointSeconds = 60;
+
+    // Called after each depth with the number of entries at that depth
+    // (for a resumed build, first for the depths already done).
+    std::function<void(int depth, uint64_t entries)> onLevel;
+    std::function<void(const PatternCheckpointEvent &)> onCheckpoint;
+};
+
+class PatternDatabase
+{
+public:
+    static uint64_t entryCount(PatternKind kind);
+
+    // The entry describing `cube`'s pieces of this kind.
+    static uint64_t index(PatternKind kind, const CubieCube &cube);
+
+    // Builds the table by breadth-first search from the solved cube, in
+    // memory from TableMemory (huge pages unless the options say otherwise).
+    // Returns false if the memory cannot be allocated.
+    bool build(PatternKind kind, const PatternBuildOptions &options = PatternBuildOptions());
+
+    // Repacks a nibble table as distances mod 3 in fresh memory of the given
+    // policy. Returns false, leaving the table as it was, if that memory
+    // cannot be allocated.
+    bool encodeMod3(PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE);
+
+    // Writes the table file. Returns false on any write error.
+    bool save(const std::string &path) const;
+
+    // Reads a table file into fresh memory (huge pages where possible), or
+    // maps it in place. Both return false, leaving the database empty, if the
+    // file is missing or is not a valid table.
+    bool load(const std::string &path, PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE);
+    bool map(const std::string &path, PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE);
+
+    bool isLoaded() const
+    {
+        return entries != nullptr;
+    }
+
+    PatternKind kind() const
+    {
+        return static_cast<PatternKind>(header().kind);
+    }
+
+    int maxDistance() const
+    {
+        return static_cast<int>(header().maxDistance);
+    }
+
+    uint32_t encoding() const
+    {
+        return header().encoding;
+    }
+
+    // The stored value of entry i: its distance, or the distance mod 3.
+    int entry(uint64_t i) const
+    {
+        if (mod3)
+            return (entries[i >> 2] >> ((i & 3) << 1)) & 3;
+        return (entries[i >> 1] >> ((i & 1) << 2)) & 0xF;
+    }
+
+    // The distance of `cube`. A mod-3 table has to walk it down to the goal,
+    // up to 18 probes per move of distance; searches should pass along the
+    // distance of the cube they came from instead.
+    int lookup(const CubieCube &cube) const
+    {
+        return mod3 ? walkToGoal(cube) : entry(index(kind(), cube));
+    }
+
+    // The distance of `cube`, given the distance of a cube one move away.
+    int lookup(const CubieCube &cube, int neighbor) const
+    {
+        int stored = entry(index(kind(), cube));
+        if (!mod3)
+            return stored;
+        // neighbor - 1, neighbor and neighbor + 1 have different residues.
+        int step = (stored - neighbor % 3 + 3) % 3;
+        return neighbor + (step == 2 ? -1 : step);
+    }
+
+    // The whole image, header included.
+    const TableMemory &memory() const
+    {
+        return image;
+    }
+
+private:
+    const PatternDatabaseHeader &header() const
+    {
+        return *reinterpret_cast<const PatternDatabaseHeader *>(image.data());
+    }
+
+    bool validate();
+    int walkToGoal(const CubieCube &cube) const;
+
+    TableMemory image;
+    const uint8_t *entries = nullptr;
+    bool mod3 = false;
+};
+
+// Admissible heuristic for IDAstarSolver<CubieCube>: the largest distance any
+// of the loaded databases gives. Databases that are not loaded are skipped.
+//
+// IDA* calls it with the depth of each node, parents before children, so it
+// keeps every database's distance along the current path and mod-3 tables
+// recover each node's distance from its parent's with a single probe.
+struct PatternDatabaseHeuristic
+{
+    static constexpr int MAX_PATH = MoveStack<CubieCube>::CAPACITY + 1;
+
+    const PatternDatabase *databases[NUM_PATTERN_KINDS] = {nullptr, nullptr, nullptr};
+    int path[MAX_PATH][NUM_PATTERN_KINDS] = {};
+
+    int operator()(const CubieCube &cube, SearchStats &stats) const
+    {
+        int h = 0;
+        for (const PatternDatabase *database : databases)
+        {
+            if (database && database->isLoaded())
+            {
+                RUBIKS_STATS(stats.tableProbes++);
+                h = std::max(h, database->lookup(cube));
+            }
+        }
+        return h;
+    }
+
+    int operator()(const CubieCube &cube, int depth, SearchStats &stats)
+    {
+        int h = 0;
+        for (int k = 0; k < NUM_PATTERN_KINDS; k++)
+        {
+            const PatternDatabase *database = databases[k];
+            if (database && database->isLoaded())
+            {
+                RUBIKS_STATS(stats.tableProbes++);
+                int d = depth == 0 ? database->lookup(cube) : database->lookup(cube, path[depth - 1][k]);
+                path[depth][k] = d;
+                h = std::max(h, d);
+            }
+        }
+        return h;
+    }
+};
+
+#endif // PATTERN_DATABASE_H
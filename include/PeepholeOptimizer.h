@@ -0,0 +1,63 @@
+#ifndef PEEPHOLE_OPTIMIZER_H
+#define PEEPHOLE_OPTIMIZER_H
+
+#include "PackedState.h"
+#include <vector>
+
+// Shortens solutions by replacing short stretches of moves with optimal
+// equivalents. The optimizer precomputes every position within `depth` moves
+// of solved (by breadth-first search) together with the last move of an
+// optimal path to it; a window of moves whose net effect is in the table can
+// then be replaced by a sequence of exactly the optimal length.
+//
+// The table holds every position up to the depth. Depth 5 holds ~620k
+// positions in 16 MB and builds in well under a second in an optimised build;
+// depth 6 holds ~8.2M (7.6M at depth 6 itself) in 256 MB.
+class PeepholeOptimizer
+{
+public:
+    static constexpr int MAX_DEPTH = 7;
+
+    // Builds the table. `maxWindow` is the longest stretch of moves examined
+    // at once (0 means twice the depth).
+    explicit PeepholeOptimizer(int depth = 5, int maxWindow = 0);
+
+    int depth() const { return tableDepth; }
+    size_t positions() const { return count; }
+
+    // Optimal distance to the solved state, or -1 if beyond the table depth.
+    int distance(const CubieCube &cube) const;
+
+    // Writes an optimal sequence producing `cube` from solved and returns its
+    // length, or -1 if `cube` is beyond the table depth.
+    int optimalSequence(const CubieCube &cube, Move *out) const;
+
+    // Rewrites `moves` in place with the same net effect and returns the new
+    // length, which is never longer. At each position the window with the
+    // largest saving is replaced, and the scan resumes just before the splice.
+    // A 30-move solution takes about 15 us with the depth-5 table.
+    size_t optimize(Move *moves, size_t length) const;
+    std::vector<Move> optimize(const std::vector<Move> &moves) const;
+
+private:
+    // Slot layout: the packed state, with bits 52-55 of `lo` holding the
+    // depth and bits 56-60 the last move. An empty slot has lo == 0, which no
+    // real state packs to.
+    struct Slot
+    {
+        uint64_t lo;
+        uint64_t hi;
+    };
+
+    const Slot *find(const PackedState &state) const;
+    bool insert(const PackedState &state, int depth, int lastMove);
+    void grow();
+
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t count = 0;
+    int tableDepth;
+    int window;
+};
+
+#endif // PEEPHOLE_OPTIMIZER_H
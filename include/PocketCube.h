@@ -0,0 +1,49 @@
+#ifndef POCKET_CUBE_H
+#define POCKET_CUBE_H
+
+#include "CubieCube.h"
+
+// The 2x2x2 cube: just the eight corners, in the same slot and twist
+// conventions as CubieCube. All 18 face turns apply. With no centers to fix
+// the orientation, a state counts as solved in any of its 24 whole-cube
+// rotations.
+//
+// Stickers use a 24-entry layout like the 3x3 models: face * 4 + row * 2 + col.
+struct PocketCube
+{
+    static constexpr int NUM_STICKERS = 24;
+
+    uint8_t cp[8];
+    uint8_t co[8];
+
+    // Constructor: the solved cube.
+    PocketCube();
+
+    // Applies `other` after this state, as in CubieCube::multiply.
+    void multiply(const PocketCube &other);
+
+    void move(Move m);
+    void apply(const Move *moves, size_t count);
+
+    PocketCube inverse() const;
+
+    bool isSolved() const;
+    bool operator==(const PocketCube &other) const;
+
+    // False if the corners are not a permutation or are twisted illegally.
+    bool isValid() const;
+
+    // The whole-cube rotation r (one of 24) for which this * r has the DBL
+    // corner home and untwisted.
+    static const PocketCube &rotation(int index);
+    int normalizingRotation() const;
+
+    void toStickers(RubiksCube::Color *stickers) const;
+    // Returns false if some corner's colors are not a real corner.
+    bool fromStickers(const RubiksCube::Color *stickers);
+
+    // The corners of a 3x3 model.
+    bool fromCube(const RubiksCube &cube);
+};
+
+#endif // POCKET_CUBE_H
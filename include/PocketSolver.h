@@ -0,0 +1,40 @@
+#ifndef POCKET_SOLVER_H
+#define POCKET_SOLVER_H
+
+#include "PocketCube.h"
+#include <vector>
+
+// Optimal 2x2x2 solver by table lookup. Holding the DBL corner fixed leaves
+// 7! * 3^6 = 3,674,160 positions reachable with U, R and F turns; a
+// breadth-first search over them stores, in one byte per position, the
+// distance (half-turn metric, at most 11) and a move that gets one closer.
+// Solving walks the table, so it costs one lookup per move.
+//
+// The 3.5 MB table is built on first use (about 0.2 s in an
+// optimised build) and shared by all solvers.
+class PocketSolver
+{
+public:
+    static constexpr int NUM_STATES = 3674160;
+
+    PocketSolver();
+
+    // Optimal number of moves, or -1 for an invalid state.
+    int distance(const PocketCube &cube) const;
+
+    // Writes an optimal solution; returns false for an invalid state. Any of
+    // the 18 moves may appear, since the table's U R F moves are translated
+    // back to the orientation the cube was given in.
+    bool solve(const PocketCube &cube, std::vector<Move> &solution) const;
+
+    // Index of a state whose DBL corner is home and untwisted.
+    static int stateIndex(const PocketCube &cube);
+
+private:
+    struct Tables;
+    static const Tables &tables();
+
+    const Tables &t;
+};
+
+#endif // POCKET_SOLVER_H
@@ -0,0 +1,83 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+
+// Scoped cycle timers and counters for hot paths. They only exist in builds
+// with -DRUBIKS_PROFILE (the `profile` Makefile target); otherwise the macros
+// expand to nothing and the instrumented code is unchanged.
+//
+//   RUBIKS_PROFILE_SCOPE("TwoPhase::phase2");  // times the enclosing scope
+//   RUBIKS_PROFILE_COUNT("TwoPhase::nodes", 1); // adds to a counter
+//
+// Each thread accumulates into its own slots, merged into the global totals
+// when the thread exits. A per-site summary is written to stderr at program
+// exit. Times are read with rdtsc on x86 and clock_gettime elsewhere, and
+// nested scopes are counted inclusively.
+#ifdef RUBIKS_PROFILE
+#define RUBIKS_PROFILE_ENABLED 1
+#define RUBIKS_PROFILE_JOIN2(a, b) a##b
+#define RUBIKS_PROFILE_JOIN(a, b) RUBIKS_PROFILE_JOIN2(a, b)
+#define RUBIKS_PROFILE_SCOPE(name)                                                   \
+    static ProfileSite RUBIKS_PROFILE_JOIN(rubiksProfileSite, __LINE__)(name);      \
+    ScopedTimer RUBIKS_PROFILE_JOIN(rubiksProfileTimer, __LINE__)(RUBIKS_PROFILE_JOIN(rubiksProfileSite, __LINE__))
+#define RUBIKS_PROFILE_COUNT(name, amount)   \
+    do                                       \
+    {                                        \
+        static ProfileSite site(name);       \
+        site.add(amount);                    \
+    } while (0)
+#else
+#define RUBIKS_PROFILE_ENABLED 0
+#define RUBIKS_PROFILE_SCOPE(name) \
+    do                             \
+    {                              \
+    } while (0)
+#define RUBIKS_PROFILE_COUNT(name, amount) \
+    do                                     \
+    {                                      \
+    } while (0)
+#endif
+
+#if RUBIKS_PROFILE_ENABLED
+
+// Current time in ticks (TSC cycles on x86, nanoseconds elsewhere).
+uint64_t profileTicks();
+
+// One instrumented location, registered on first use.
+class ProfileSite
+{
+public:
+    static constexpr int MAX_SITES = 256;
+
+    explicit ProfileSite(const char *name);
+
+    // Records one timed call, or adds to the site's counter.
+    void record(uint64_t ticks);
+    void add(uint64_t amount);
+
+private:
+    int id;
+};
+
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(ProfileSite &site) : site(site), start(profileTicks()) {}
+    ~ScopedTimer() { site.record(profileTicks() - start); }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    ProfileSite &site;
+    uint64_t start;
+};
+
+// Writes the summary of every finished thread plus the calling thread.
+void profileReport(std::ostream &out);
+
+#endif // RUBIKS_PROFILE_ENABLED
+
+#endif // PROFILER_H
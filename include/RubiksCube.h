@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <string>
+#include "Move.h"
+
+class ScrambleGenerator;
 
 // Abstract base class for a Rubik's Cube model.
 class RubiksCube
@@ -62,12 +65,34 @@ public:
     // Pure virtual function to check if the cube is in a solved state.
     virtual bool isSolved() const = 0;
 
+    // Applies a single move.
+    void move(Move m);
+
+    // Applies a sequence of moves. The default goes through the virtual move
+    // functions; models override it with a loop that avoids per-move dispatch.
+    virtual void apply(const Move *moves, size_t count);
+
+    // Number of stickers, including the six centers.
+    static constexpr int NUM_STICKERS = 54;
+
+    // The five 4-cycles of sticker indices moved by a clockwise turn of each face.
+    static const int STICKER_CYCLES[6][5][4];
+
+    // Copies all 54 sticker colors out, indexed face * 9 + row * 3 + col.
+    virtual void getStickers(Color *stickers) const;
+
+    // Replaces the whole state with the given 54 sticker colors (same layout).
+    virtual void setStickers(const Color *stickers) = 0;
+
     // Generic print function.
     void print() const;
 
     // Randomly shuffles the cube.
     void randomShuffle(unsigned int times);
 
+    // Shuffles with moves drawn from a seeded generator, for reproducible runs.
+    void randomShuffle(unsigned int times, ScrambleGenerator &generator);
+
     // Returns a string representation of a move.
     std::string getMove(int ind);
 
@@ -75,6 +100,15 @@ protected:
     // Pure virtual helper function to get the color of a specific sticker on a face.
     // This must be implemented by derived classes.
     virtual Color getColor(Face face, unsigned int row, unsigned int col) const = 0;
+
+    // Applies a move to 54 stickers stored face by face (face * 9 + row * 3 + col),
+    // the layout shared by the 1D and 3D array models.
+    static void applyStickerMove(Color *stickers, Move m);
+
+    // Applies a move sequence to stickers in the same layout. Longer
+    // sequences go through the batch kernel chosen for this CPU (see
+    // Kernels.h), which keeps the whole cube in vector registers.
+    static void applyStickerMoves(Color *stickers, const Move *moves, size_t count);
 };
 
 #endif // RUBIKS_CUBE_H
\ No newline at end of file
@@ -29,6 +29,12 @@ public:
 
     bool isSolved() const override;
 
+    void getStickers(Color *stickers) const override;
+    void setStickers(const Color *stickers) override;
+
+    // Applies each move in a single pass over the affected stickers.
+    void apply(const Move *moves, size_t count) override;
+
     // --- Overridden Move Functions ---
 
     void u() override;
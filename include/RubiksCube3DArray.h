@@ -23,8 +23,8 @@ public:
 
     // Default virtual destructor.
     ~RubiksCube3DArray() override = default;
+    // Copying uses the implicit member-wise copy: one block copy of `grid`.
     bool operator==(const RubiksCube3DArray &other) const;
-    RubiksCube3DArray &operator=(const RubiksCube3DArray &other);
 
     // --- Overridden Public Interface from RubiksCube ---
 
@@ -34,6 +34,12 @@ public:
     // Checks if the cube is in the solved state.
     bool isSolved() const override;
 
+    void getStickers(Color *stickers) const override;
+    void setStickers(const Color *stickers) override;
+
+    // Applies each move in a single pass over the affected stickers.
+    void apply(const Move *moves, size_t count) override;
+
     // --- Overridden Move Functions ---
     // Note: They return a reference to the object to allow for method chaining (e.g., cube.u().r())
 
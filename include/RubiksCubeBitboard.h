@@ -18,6 +18,9 @@ private:
     // Helper to decode a color from a face's bitboard given a sticker index.
     Color getColorFromSticker(int face_idx, int sticker_idx) const;
 
+    // Turns a face clockwise by the given number of quarter turns (1-3).
+    void turn(int face_idx, int quarter_turns);
+
 public:
     // Constructor: Initializes the cube to a solved state.
     RubiksCubeBitboard();
@@ -29,6 +32,13 @@ public:
     Color getColor(Face face, unsigned int row, unsigned int col) const override;
     bool isSolved() const override;
 
+    // Centers are implied by the face, so setStickers ignores the six center entries.
+    void getStickers(Color *stickers) const override;
+    void setStickers(const Color *stickers) override;
+
+    // Applies each move as one turn() call, without going through the virtual moves.
+    void apply(const Move *moves, size_t count) override;
+
     // --- Overridden Move Functions ---
     void u() override;
     void uPrime() override;
@@ -0,0 +1,40 @@
+#ifndef SCRAMBLE_GENERATOR_H
+#define SCRAMBLE_GENERATOR_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include "Xoshiro256.h"
+#include <cstddef>
+#include <cstdint>
+
+// Seedable, allocation-free scramble source. The same seed always yields the
+// same sequence of scrambles, so test runs can be reproduced.
+class ScrambleGenerator
+{
+private:
+    Xoshiro256 rng;
+
+public:
+    explicit ScrambleGenerator(uint64_t seed);
+
+    void seed(uint64_t value);
+
+    // Writes a random walk of `length` canonical moves: never the same face
+    // twice in a row, and turns of opposite faces only in U L F before D R B
+    // order, so no two scrambles differ only by a trivially redundant move.
+    void randomMoves(Move *out, size_t length);
+
+    // Writes `count` walks of `length` moves back to back into `out`, which
+    // must hold count * length moves.
+    void randomMovesBatch(Move *out, size_t count, size_t length);
+
+    // Draws a state uniformly from all 43,252,003,274,489,856,000 reachable
+    // positions by sampling the pieces directly: any corner and edge
+    // permutation of equal parity, any corner twists summing to 0 mod 3 and
+    // any edge flips summing to 0 mod 2.
+    CubieCube randomState();
+
+    void randomStates(CubieCube *out, size_t count);
+};
+
+#endif // SCRAMBLE_GENERATOR_H
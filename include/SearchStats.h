@@ -0,0 +1,74 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Statistics hooks used inside the solvers' hot loops. Building with
+// -DRUBIKS_NO_STATS (the `fast` Makefile target) turns every hook into an
+// empty statement, so the zero-overhead build does not even read the clock.
+#ifdef RUBIKS_NO_STATS
+#define RUBIKS_STATS_ENABLED 0
+#define RUBIKS_STATS(statement) \
+    do                          \
+    {                           \
+    } while (0)
+#else
+#define RUBIKS_STATS_ENABLED 1
+#define RUBIKS_STATS(statement) \
+    do                          \
+    {                           \
+        statement;              \
+    } while (0)
+#endif
+
+// Counters filled in by a solver during one solve.
+// Fixed-size arrays keep the per-node cost to a single increment; the vectors
+// only grow once per IDA* iteration.
+struct SearchStats
+{
+    static constexpr int MAX_DEPTH = 32;
+    static constexpr int MAX_HEURISTIC = 32;
+
+    // Nodes expanded at each distance from the root, summed over all iterations.
+    uint64_t nodesPerDepth[MAX_DEPTH];
+
+    // How often each heuristic value was returned.
+    uint64_t heuristicHistogram[MAX_HEURISTIC];
+
+    // Children discarded because g + h exceeded the current bound.
+    uint64_t prunedByBound;
+
+    // Children never generated because the move is redundant after the previous one.
+    uint64_t prunedByMoveRules;
+
+    // Lookups into heuristic or cache tables, and how many of them found an entry.
+    uint64_t tableProbes;
+    uint64_t tableHits;
+
+    // One entry per IDA* iteration.
+    std::vector<int> iterationBounds;
+    std::vector<uint64_t> iterationNodes;
+    std::vector<double> iterationMillis;
+
+    double totalMillis;
+    int solutionLength;
+
+    SearchStats();
+
+    // Clears all counters for a new solve.
+    void reset();
+
+    uint64_t totalNodes() const;
+
+    // Growth of the node count between the last two iterations, per unit of bound.
+    double effectiveBranchingFactor() const;
+
+    double nodesPerSecond() const;
+
+    // Serialises the statistics as a single-line JSON object.
+    std::string toJson() const;
+};
+
+#endif // SEARCH_STATS_H
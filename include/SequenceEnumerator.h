@@ -0,0 +1,141 @@
+#ifndef SEQUENCE_ENUMERATOR_H
+#define SEQUENCE_ENUMERATOR_H
+
+#include "Move.h"
+#include <vector>
+
+// Stand-in state for enumerating move sequences without a cube.
+struct NoState
+{
+    void apply(const Move *, size_t) {}
+};
+
+// Lazily walks every canonical move sequence of one length: no face turned
+// twice in a row and opposite faces only in U L F before D R B order (see
+// isCanonicalAfter), which is what the solvers expand. Sequences come in
+// lexicographic order of their move indices, each with the state it leads to
+// from `start`; the state is turned forwards and back along the way, so
+// nothing is stored beyond the current path and consumers can stop at any
+// point.
+//
+// All sequences can be split into disjoint shards by their first moves:
+// canonicalPrefixes(p) lists the possible first p moves, and an enumerator
+// given one of them only walks the sequences that start with it.
+//
+//     SequenceEnumerator<CubieCube> sequences(CubieCube(), 6);
+//     while (sequences.next())
+//         use(sequences.moves(), sequences.length(), sequences.state());
+//
+// T is any type with apply(const Move *, size_t); NoState walks sequences only.
+// Note that distinct sequences often reach the same state; enumerating
+// distinct states needs memory for the states seen (see ExternalBFS).
+template <typename T = NoState>
+class SequenceEnumerator
+{
+public:
+    // `prefix` (canonical, at most `length` moves) is applied first and kept.
+    // A negative length is an error and walks no sequences at all.
+    SequenceEnumerator(const T &start, int length, const std::vector<Move> &prefix = std::vector<Move>())
+        : work(start), path(prefix), fixed(static_cast<int>(prefix.size())), started(length < 0)
+    {
+        if (length < 0)
+        {
+            path.clear();
+            fixed = 0;
+            return;
+        }
+        path.resize(length > fixed ? length : fixed);
+        work.apply(path.data(), fixed);
+    }
+
+    // Moves to the next sequence; false once all have been visited.
+    bool next()
+    {
+        int length = static_cast<int>(path.size());
+        if (!started)
+        {
+            started = true;
+            fill(fixed);
+            return true;
+        }
+        // Undo moves from the end until one can be replaced by a later one.
+        for (int level = length - 1; level >= fixed; level--)
+        {
+            undo(level);
+            int last = level > 0 ? moveFace(path[level - 1]) : -1;
+            for (int m = static_cast<int>(path[level]) + 1; m < NUM_MOVES; m++)
+            {
+                if (isCanonicalAfter(moveFace(static_cast<Move>(m)), last))
+                {
+                    set(level, static_cast<Move>(m));
+                    fill(level + 1);
+                    return true;
+                }
+            }
+        }
+        // Leaves the state back at start + prefix.
+        path.resize(fixed);
+        return false;
+    }
+
+    const Move *moves() const
+    {
+        return path.data();
+    }
+
+    int length() const
+    {
+        return static_cast<int>(path.size());
+    }
+
+    const T &state() const
+    {
+        return work;
+    }
+
+    // Every canonical sequence of `length` moves, for use as shard prefixes:
+    // 18 for one move, 243 for two, 3240 for three. None for a negative length.
+    static std::vector<std::vector<Move>> canonicalPrefixes(int length)
+    {
+        std::vector<std::vector<Move>> prefixes;
+        SequenceEnumerator<NoState> sequences(NoState(), length);
+        while (sequences.next())
+            prefixes.emplace_back(sequences.moves(), sequences.moves() + length);
+        return prefixes;
+    }
+
+private:
+    void set(int level, Move m)
+    {
+        path[level] = m;
+        work.apply(&m, 1);
+    }
+
+    void undo(int level)
+    {
+        Move back = inverse(path[level]);
+        work.apply(&back, 1);
+    }
+
+    // Puts the first canonical move at each level from `level` on; there is
+    // always one, as at most two faces are ruled out.
+    void fill(int level)
+    {
+        for (; level < static_cast<int>(path.size()); level++)
+        {
+            int last = level > 0 ? moveFace(path[level - 1]) : -1;
+            int face = 0;
+            while (!isCanonicalAfter(face, last))
+                face++;
+            set(level, makeMove(face, 1));
+        }
+    }
+
+    T work;
+    std::vector<Move> path;
+    int fixed;
+    // Set from the start for a negative length, whose next() then finds nothing.
+    bool started;
+};
+
+#endif // SEQUENCE_ENUMERATOR_H
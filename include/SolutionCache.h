@@ -0,0 +1,77 @@
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include "Symmetry.h"
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct CacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;
+    size_t size;
+
+    double hitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0; }
+};
+
+// A bounded least-recently-used cache of solutions, safe to share between
+// threads. Entries are keyed by the symmetry-canonical state (see Symmetry.h),
+// so a position asked for in any of its 48 orientations or mirror images hits
+// the same entry; the stored solution is mapped through the symmetry on the
+// way in and out. The key space is split into shards with one lock each, so
+// concurrent lookups rarely wait for each other.
+//
+// Only solutions that actually solve the state are stored, so a failed or
+// cancelled solve (an empty move list) is never served as "already solved".
+//
+// Computing the canonical key costs about 45 us at -O2, far below any search
+// but well above Thistlethwaite's table walk.
+class SolutionCache
+{
+public:
+    // `capacity` entries in total, spread evenly over `shards` shards.
+    explicit SolutionCache(size_t capacity, size_t shards = 16);
+
+    // Returns true and fills `solution` if an equivalent state is cached.
+    bool lookup(const CubieCube &cube, std::vector<Move> &solution);
+    // Does nothing if `solution` does not solve `cube`.
+    void insert(const CubieCube &cube, const std::vector<Move> &solution);
+
+    // Looks `cube` up and, on a miss, solves it with `solver` and caches the
+    // result if it solves the cube.
+    std::vector<Move> solve(const CubieCube &cube, const std::function<std::vector<Move>(const CubieCube &)> &solver);
+
+    // The same with a key the caller computed with canonicalState(), for
+    // callers that both look up and insert. `symmetry` takes the caller's
+    // state to `key`; insertCanonical() trusts that `solution` solves it.
+    bool lookupCanonical(const PackedState &key, int symmetry, std::vector<Move> &solution);
+    void insertCanonical(const PackedState &key, int symmetry, const std::vector<Move> &solution);
+
+    CacheStats stats() const;
+    void clear();
+
+private:
+    struct Shard
+    {
+        typedef std::list<std::pair<PackedState, std::vector<Move>>> Entries;
+
+        mutable std::mutex mutex;
+        // Most recently used first.
+        Entries entries;
+        std::unordered_map<PackedState, Entries::iterator, PackedStateHash> index;
+        size_t capacity = 0;
+        uint64_t hits = 0, misses = 0, insertions = 0, evictions = 0;
+    };
+
+    Shard &shardFor(const PackedState &key);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+#endif // SOLUTION_CACHE_H
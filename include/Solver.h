@@ -0,0 +1,147 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "PatternDatabase.h"
+#include "SolutionCache.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// What the caller wants from a solve.
+enum class SolvePolicy
+{
+    OPTIMAL, // a shortest solution, however long it takes
+    BOUNDED, // any solution of at most maxLength moves, as fast as possible
+    FASTEST  // any solution, as fast as possible
+};
+
+// The engines a request can be routed to.
+enum class SolverEngine
+{
+    NONE,           // answered by the probe alone: invalid, already solved, or no solution can be short enough
+    IDA_STAR,       // optimal search guided by the pattern databases
+    THISTLETHWAITE, // table walk, microseconds, about 31 moves
+    TWO_PHASE,      // near-optimal search, stops at the length asked for
+    CACHE           // a solution found earlier for the same position in some orientation
+};
+
+constexpr int NUM_SOLVER_ENGINES = 5;
+
+const char *solverEngineName(SolverEngine engine);
+
+struct SolveRequest
+{
+    SolvePolicy policy = SolvePolicy::FASTEST;
+    // Longest solution accepted under BOUNDED.
+    int maxLength = 20;
+    // How long a two-phase search may take under BOUNDED.
+    std::chrono::milliseconds timeLimit{1000};
+};
+
+struct SolveResponse
+{
+    bool solved = false; // false if no solution meeting the request was found
+    std::vector<Move> solution;
+    SolverEngine engine = SolverEngine::NONE; // the engine whose answer was returned
+    int lowerBound = 0;                       // from the probe
+    bool optimal = false;                     // the solution is known to be shortest
+    double micros = 0;                        // whole request, probe included
+};
+
+// Latency buckets: bucket b counts calls taking [2^(b-1), 2^b) microseconds,
+// bucket 0 those under a microsecond, and the last everything longer.
+constexpr int LATENCY_BUCKETS = 32;
+
+struct EngineStats
+{
+    uint64_t routed;  // requests this engine answered
+    uint64_t calls;   // times it ran, including attempts that fell through to another engine
+    uint64_t latency[LATENCY_BUCKETS];
+};
+
+struct SolverStats
+{
+    EngineStats engines[NUM_SOLVER_ENGINES];
+};
+
+// Front end that picks an engine per request. A state that cannot be reached
+// by turning faces is answered unsolved by NONE right away. Otherwise it
+// takes a lower bound on the distance from the pattern databases (three
+// table lookups) and then routes:
+//   OPTIMAL  -> IDA*.
+//   BOUNDED  -> nothing if the bound already exceeds maxLength; IDA*, with
+//               its depth capped, if the bound says the cube is close to
+//               solved; otherwise Thistlethwaite if its solution is short
+//               enough, else two-phase aiming at maxLength.
+//   FASTEST  -> IDA* for cubes a few moves from solved, where it is about as
+//               quick and far shorter, Thistlethwaite otherwise.
+// An engine that fails (IDA* past its cap) falls through to the next one.
+//
+// With enableCache(), OPTIMAL and BOUNDED requests first look the position
+// up in a SolutionCache, which keeps the IDA* and two-phase solutions. A
+// cached solution answers OPTIMAL if its length equals the lower bound (so
+// it is provably shortest) and BOUNDED if it is short enough; otherwise the
+// request is routed as usual. FASTEST skips the cache, as the canonical key
+// costs more than Thistlethwaite's whole solve.
+//
+// The IDA* routes for BOUNDED and FASTEST are only taken when all three
+// pattern databases are loaded. Without them the bound comes from counting
+// misplaced pieces, which is much weaker: it never exceeds 3, and IDA* on it
+// is slow even a few moves out, so those requests go straight to
+// Thistlethwaite (and two-phase for BOUNDED). OPTIMAL still uses IDA*.
+//
+// solve() may be called from several threads at once; the statistics are
+// kept with atomic counters.
+class Solver
+{
+public:
+    Solver();
+
+    Solver(const Solver &) = delete;
+    Solver &operator=(const Solver &) = delete;
+
+    // Loads corners.pdb, edges-first.pdb and edges-last.pdb from `directory`
+    // and returns how many were found.
+    int loadPatternDatabases(const std::string &directory);
+
+    // Builds the databases that are not loaded (about 10 s for all three)
+    // and, if `directory` is given, saves them there.
+    void buildPatternDatabases(const std::string &directory = "");
+
+    // A lower bound on the number of moves `cube` needs.
+    int lowerBound(const CubieCube &cube) const;
+
+    SolveResponse solve(const CubieCube &cube, const SolveRequest &request = SolveRequest());
+
+    // Keeps up to `capacity` solutions in a cache in front of the engines; 0
+    // turns the cache off again. Not to be called while solves are running.
+    void enableCache(size_t capacity);
+    // All zero while the cache is off.
+    CacheStats cacheStats() const;
+
+    SolverStats stats() const;
+    void resetStats();
+
+private:
+    struct AtomicEngineStats
+    {
+        std::atomic<uint64_t> routed{0};
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> latency[LATENCY_BUCKETS] = {};
+    };
+
+    // Solves with IDA* up to `maxDepth` moves; false if there is no solution
+    // that short.
+    bool solveExact(const CubieCube &cube, int maxDepth, std::vector<Move> &solution);
+    // True when all three pattern databases are loaded.
+    bool databasesLoaded() const;
+    void record(SolverEngine engine, std::chrono::steady_clock::time_point start);
+
+    PatternDatabase databases[NUM_PATTERN_KINDS];
+    AtomicEngineStats engineStats[NUM_SOLVER_ENGINES];
+    std::unique_ptr<SolutionCache> cache;
+};
+
+#endif // SOLVER_H
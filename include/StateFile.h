@@ -0,0 +1,154 @@
+#ifndef STATE_FILE_H
+#define STATE_FILE_H
+
+#include "Move.h"
+#include "PackedState.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Binary files of fixed-size cube-state records, read and written through
+// mmap so large batches stream without per-record parsing or copies.
+//
+// Layout: a 32-byte StateFileHeader followed by `recordCount` records of
+// `recordSize` bytes each. Every record starts with a PackedState; the header
+// flags say which optional fields follow it:
+//   STATE_FILE_IDS        uint64_t id
+//   STATE_FILE_SOLUTIONS  uint8_t length + STATE_FILE_MAX_SOLUTION moves
+// Multi-byte fields are stored in the host's (little-endian) byte order.
+enum StateFileFlags : uint32_t
+{
+    STATE_FILE_IDS = 1,
+    STATE_FILE_SOLUTIONS = 2
+};
+
+constexpr uint32_t STATE_FILE_VERSION = 1;
+constexpr size_t STATE_FILE_MAX_SOLUTION = 31;
+// Stored as the solution length of records that have no solution yet.
+constexpr uint8_t STATE_FILE_NO_SOLUTION = 0xFF;
+
+struct StateFileHeader
+{
+    char magic[8]; // "RUBIKSST"
+    uint32_t version;
+    uint32_t flags;
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t recordCount;
+};
+
+static_assert(sizeof(StateFileHeader) == 32, "StateFileHeader must stay 32 bytes");
+
+// Record size for a set of flags.
+size_t stateRecordSize(uint32_t flags);
+
+// A read-only view of one record inside a mapped file.
+class StateRecordView
+{
+public:
+    StateRecordView(const uint8_t *record, uint32_t flags) : record(record), flags(flags) {}
+
+    const PackedState &state() const { return *reinterpret_cast<const PackedState *>(record); }
+    bool hasId() const { return flags & STATE_FILE_IDS; }
+    uint64_t id() const;
+    // False for files without solutions and for records whose solution slot
+    // is still empty.
+    bool hasSolution() const;
+    size_t solutionLength() const;
+    const Move *solution() const;
+
+private:
+    const uint8_t *record;
+    uint32_t flags;
+};
+
+class StateFileReader
+{
+public:
+    StateFileReader() = default;
+    ~StateFileReader();
+
+    StateFileReader(const StateFileReader &) = delete;
+    StateFileReader &operator=(const StateFileReader &) = delete;
+
+    // Maps `path` and checks its header. Returns false (and stays closed) if
+    // the file cannot be opened or is not a valid state file.
+    bool open(const std::string &path);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    size_t size() const { return count; }
+    uint32_t flags() const { return fileFlags; }
+
+    StateRecordView operator[](size_t index) const
+    {
+        return StateRecordView(records + index * recordSize, fileFlags);
+    }
+
+    class Iterator
+    {
+    public:
+        Iterator(const StateFileReader *reader, size_t index) : reader(reader), index(index) {}
+        StateRecordView operator*() const { return (*reader)[index]; }
+        Iterator &operator++()
+        {
+            index++;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return index != other.index; }
+
+    private:
+        const StateFileReader *reader;
+        size_t index;
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, count); }
+
+private:
+    void *base = nullptr;
+    size_t mappedBytes = 0;
+    const uint8_t *records = nullptr;
+    size_t recordSize = 0;
+    size_t count = 0;
+    uint32_t fileFlags = 0;
+};
+
+// Appends records to a new file. The file is grown and mapped in large steps,
+// so each append is a copy into the mapping; close() trims the file to its
+// records and writes the final count into the header.
+class StateFileWriter
+{
+public:
+    StateFileWriter() = default;
+    ~StateFileWriter();
+
+    StateFileWriter(const StateFileWriter &) = delete;
+    StateFileWriter &operator=(const StateFileWriter &) = delete;
+
+    // Creates (or truncates) `path`. Returns false if it cannot be created.
+    bool create(const std::string &path, uint32_t flags);
+
+    // Fields the file does not store are ignored. Solutions longer than
+    // STATE_FILE_MAX_SOLUTION moves are rejected; pass no solution to leave
+    // the slot empty. Returns false on error.
+    bool append(const PackedState &state, uint64_t id = 0, const Move *solution = nullptr, size_t solutionLength = 0);
+
+    // Flushes and closes the file. Returns false if any write failed.
+    bool close();
+
+    size_t size() const { return count; }
+
+private:
+    bool reserve(size_t records);
+
+    int fd = -1;
+    uint8_t *base = nullptr;
+    size_t mappedBytes = 0;
+    size_t recordSize = 0;
+    size_t count = 0;
+    uint32_t fileFlags = 0;
+    bool failed = false;
+};
+
+#endif // STATE_FILE_H
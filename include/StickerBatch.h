@@ -0,0 +1,53 @@
+#ifndef STICKER_BATCH_H
+#define STICKER_BATCH_H
+
+#include "CubeTransform.h"
+#include "Kernels.h"
+#include <cstdint>
+#include <vector>
+
+// Many cube states stored as 64-byte sticker rows, so that one move or
+// transform is applied to all of them by the CPU-dispatched batch kernels.
+class StickerBatch
+{
+private:
+    std::vector<uint8_t> rows;
+    size_t count;
+
+public:
+    // Constructor: `count` solved cubes.
+    explicit StickerBatch(size_t count);
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    uint8_t *row(size_t index)
+    {
+        return rows.data() + index * KERNEL_ROW_BYTES;
+    }
+
+    const uint8_t *row(size_t index) const
+    {
+        return rows.data() + index * KERNEL_ROW_BYTES;
+    }
+
+    // Copies a model's state into, or out of, one row.
+    void load(size_t index, const RubiksCube &cube);
+    void store(size_t index, RubiksCube &cube) const;
+
+    // Applies the same transform, move or move sequence to every cube. A
+    // sequence is composed into one transform first, so it costs one pass.
+    void apply(const CubeTransform &transform);
+    void apply(Move m);
+    void apply(const Move *moves, size_t length);
+
+    size_t countSolved() const;
+
+    // The 18 moves prepared for the active kernel, KERNEL_CONTROL_BYTES
+    // apart in move order, as KernelTable::permuteSequence takes them.
+    static const uint8_t *moveControls();
+};
+
+#endif // STICKER_BATCH_H
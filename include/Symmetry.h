@@ -0,0 +1,28 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "PackedState.h"
+
+// The 48 symmetries of the cube (24 rotations, each optionally mirrored),
+// acting on states by conjugation: the state is turned or reflected as a
+// whole and then recolored so the centers show their usual colors again.
+// Symmetric states need the same number of moves, and a solution of one
+// carries over to the other by mapping each move through the symmetry.
+// Symmetry 0 is the identity.
+constexpr int NUM_SYMMETRIES = 48;
+
+// Conjugates a sticker state (54 colors in the usual layout).
+void applySymmetry(int symmetry, const RubiksCube::Color *in, RubiksCube::Color *out);
+CubieCube applySymmetry(int symmetry, const CubieCube &cube);
+
+// The move playing the role of `m` in the conjugated state. Mirrors turn
+// clockwise moves into counter-clockwise ones.
+Move symmetryMove(int symmetry, Move m);
+
+int inverseSymmetry(int symmetry);
+
+// The smallest packed state among the 48 conjugates of `cube`, and the
+// symmetry producing it. Equivalent states share the same canonical state.
+PackedState canonicalState(const CubieCube &cube, int &symmetry);
+
+#endif // SYMMETRY_H
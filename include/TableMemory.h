@@ -0,0 +1,83 @@
+#ifndef TABLE_MEMORY_H
+#define TABLE_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Memory for large lookup tables, backed by 2 MB pages where the system
+// allows it. A pattern database probed at random touches a new 4 KB page on
+// almost every lookup, so with normal pages most probes also miss the TLB;
+// one 2 MB TLB entry covers 512 times as much table.
+//
+// Allocations try, in order:
+//   1. explicit huge pages (mmap with MAP_HUGETLB), which need pages reserved
+//      in /proc/sys/vm/nr_hugepages;
+//   2. transparent huge pages: a 2 MB aligned mapping with
+//      madvise(MADV_HUGEPAGE), which the kernel fills with huge pages when it
+//      can (THP "always" or "madvise" mode);
+//   3. normal pages.
+// pageKind() says which one was obtained.
+
+enum class PageKind
+{
+    NONE,             // nothing allocated
+    NORMAL,           // 4 KB pages
+    TRANSPARENT_HUGE, // MADV_HUGEPAGE was accepted; hugeBytes() says how much the kernel actually backs
+    EXPLICIT_HUGE     // MAP_HUGETLB: every page is 2 MB
+};
+
+const char *pageKindName(PageKind kind);
+
+enum class PagePolicy
+{
+    HUGE_IF_AVAILABLE, // the order above
+    NORMAL_ONLY        // 4 KB pages only, for comparison
+};
+
+class TableMemory
+{
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    TableMemory() = default;
+    ~TableMemory();
+
+    TableMemory(const TableMemory &) = delete;
+    TableMemory &operator=(const TableMemory &) = delete;
+    TableMemory(TableMemory &&other);
+    TableMemory &operator=(TableMemory &&other);
+
+    // Zero-filled anonymous memory of at least `bytes`. Returns false if not
+    // even normal pages could be mapped.
+    bool allocate(size_t bytes, PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE);
+
+    // Maps a whole file read-only. Explicit huge pages only work for files on
+    // a hugetlbfs mount, and transparent ones only where the kernel supports
+    // them for files, so this usually ends with normal pages; loadFile()
+    // gives anonymous huge pages at the cost of a copy.
+    bool mapFile(const std::string &path, PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE);
+
+    // Allocates memory for the whole file and reads it in.
+    bool loadFile(const std::string &path, PagePolicy policy = PagePolicy::HUGE_IF_AVAILABLE);
+
+    void release();
+
+    uint8_t *data() { return base; }
+    const uint8_t *data() const { return base; }
+    // The size asked for (or the file size), not the rounded-up mapping.
+    size_t size() const { return bytes; }
+    PageKind pageKind() const { return kind; }
+
+    // How much of the mapping the kernel backs with huge pages right now,
+    // read from /proc/self/smaps; 0 if that cannot be read.
+    size_t hugeBytes() const;
+
+private:
+    uint8_t *base = nullptr;
+    size_t bytes = 0;
+    size_t mappedBytes = 0;
+    PageKind kind = PageKind::NONE;
+};
+
+#endif // TABLE_MEMORY_H
@@ -0,0 +1,52 @@
+#ifndef THISTLETHWAITE_SOLVER_H
+#define THISTLETHWAITE_SOLVER_H
+
+#include "CubieCube.h"
+#include <vector>
+
+struct ThistlethwaiteResult
+{
+    bool solved = false; // false for a state that cannot be reached by turning faces
+    std::vector<Move> solution;
+    int phaseLength[4] = {0, 0, 0, 0};
+    double micros = 0;
+};
+
+// Thistlethwaite's algorithm, for when memory is tight. The cube is brought
+// through the chain of subgroups
+//   G0 = <U, D, L, R, F, B>
+//   G1 = <U, D, L, R, F2, B2>     edges oriented
+//   G2 = <U, D, L2, R2, F2, B2>   corners oriented, E-slice edges in the E slice
+//   G3 = <U2, D2, L2, R2, F2, B2> every piece in its own half-turn orbit
+// and then solved, each phase turning only faces its starting group allows.
+// Each phase has an exact distance table over what it has to fix:
+//   phase 1: 2048 edge flips                               (2 KB)
+//   phase 2: 2187 corner twists x 495 E-slice placements   (4 bits each, 529 KB)
+//   phase 3: 420 corner cosets x 70 M-slice placements     (29 KB)
+//   phase 4: 663,552 states of G3                          (4 bits each, 324 KB)
+// so each phase is a walk down its table. Solutions have at most
+// 7 + 10 + 13 + 15 moves and usually about 31.
+//
+// The tables (under 1 MB in all) are built on first use (well under a
+// second) and shared by all solvers.
+class ThistlethwaiteSolver
+{
+public:
+    ThistlethwaiteSolver();
+
+    ThistlethwaiteResult solve(const CubieCube &cube) const;
+    ThistlethwaiteResult solve(const RubiksCube &cube) const;
+
+    static void prepareTables();
+
+    // Memory held by the shared tables.
+    static size_t tableBytes();
+
+private:
+    struct Tables;
+    static const Tables &tables();
+
+    const Tables &t;
+};
+
+#endif // THISTLETHWAITE_SOLVER_H
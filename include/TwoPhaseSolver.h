@@ -0,0 +1,91 @@
+#ifndef TWO_PHASE_SOLVER_H
+#define TWO_PHASE_SOLVER_H
+
+#include "CubieCube.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Why a search ended.
+enum class SearchOutcome
+{
+    EXHAUSTED,      // every phase-1 depth below the best length was tried
+    TARGET_REACHED, // a solution of at most the target length was found
+    DEADLINE,
+    CANCELLED,
+    INVALID_CUBE    // the state cannot be reached by turning faces
+};
+
+struct TwoPhaseOptions
+{
+    // Longest solution accepted.
+    int maxLength = 30;
+    // Stop as soon as a solution of at most this many moves is found.
+    int targetLength = 0;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    // Polled during the search; set it from another thread to stop early.
+    const std::atomic<bool> *cancel = nullptr;
+    // Called with each solution shorter than all earlier ones.
+    std::function<void(const std::vector<Move> &)> onSolution;
+    // Shared between searches running in parallel: the shortest length any
+    // of them has found (start it at maxLength + 1). Each search only looks
+    // for solutions shorter than it, lowers it when it finds one, and stops
+    // once it reaches the target length.
+    std::atomic<int> *sharedBest = nullptr;
+};
+
+struct TwoPhaseResult
+{
+    SearchOutcome outcome;
+    bool found;                 // false if nothing within maxLength was found in time
+    std::vector<Move> solution; // the shortest solution found
+    uint64_t nodes;
+};
+
+// Kociemba's two-phase algorithm. Phase 1 searches with IDA* for move
+// sequences that bring the cube into the subgroup <U, D, L2, R2, F2, B2>
+// (no twisted corners, no flipped edges, slice edges in the slice); phase 2
+// solves from there using only those moves. Trying ever longer phase-1
+// sequences keeps producing shorter total solutions, so the search can be
+// stopped at any time with the best one so far.
+//
+// The move and pruning tables (about 6 MB) are built on first use and shared
+// by all solvers.
+class TwoPhaseSolver
+{
+public:
+    static constexpr int MAX_LENGTH = 50;
+
+    TwoPhaseSolver();
+
+    // Builds the shared tables now rather than inside the first solve, which
+    // would otherwise spend part of its deadline on them.
+    static void prepareTables();
+
+    // Memory held by the shared tables.
+    static size_t tableBytes();
+
+    TwoPhaseResult solve(const CubieCube &cube, const TwoPhaseOptions &options = TwoPhaseOptions());
+
+private:
+    struct Tables;
+    static const Tables &tables();
+
+    bool phase1(int twist, int flip, int slice, int depth, int togo, int lastFace);
+    bool startPhase2(int phase1Length);
+    bool phase2(int cornerPerm, int udEdgePerm, int slicePerm, int depth, int togo, int lastFace);
+    bool shouldStop();
+    int bestLimit() const;
+
+    const Tables &t;
+    const TwoPhaseOptions *options = nullptr;
+    CubieCube start;
+    Move path[MAX_LENGTH];
+    int bestLength = 0;
+    TwoPhaseResult result;
+    bool stopped = false;
+};
+
+#endif // TWO_PHASE_SOLVER_H
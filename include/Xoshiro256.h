@@ -0,0 +1,68 @@
+#ifndef XOSHIRO256_H
+#define XOSHIRO256_H
+
+#include <cstdint>
+
+// xoshiro256** pseudo-random generator: four words of state, a few shifts and
+// rotates per number, and fully reproducible from a 64-bit seed.
+class Xoshiro256
+{
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        this->seed(seed);
+    }
+
+    // Expands the seed with splitmix64, as recommended by the xoshiro authors.
+    void seed(uint64_t value)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            value += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = value;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            s[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, bound) using Lemire's multiply-and-reject method.
+    uint32_t below(uint32_t bound)
+    {
+        uint64_t m = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < bound)
+        {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold)
+            {
+                m = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+};
+
+#endif // XOSHIRO256_H
@@ -0,0 +1,141 @@
+#include "AsyncSolver.h"
+
+SolveHandle &SolveHandle::operator=(SolveHandle &&other)
+{
+    if (this != &other)
+    {
+        cancel();
+        if (worker.joinable())
+            worker.join();
+        shared = std::move(other.shared);
+        worker = std::move(other.worker);
+    }
+    return *this;
+}
+
+SolveHandle::~SolveHandle()
+{
+    cancel();
+    if (worker.joinable())
+        worker.join();
+}
+
+void SolveHandle::cancel()
+{
+    if (shared)
+        shared->cancel.store(true, std::memory_order_relaxed);
+}
+
+void SolveHandle::wait() const
+{
+    if (!shared)
+        return;
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->changed.wait(lock, [this] { return shared->status != Status::RUNNING; });
+}
+
+bool SolveHandle::waitUntil(std::chrono::steady_clock::time_point until) const
+{
+    if (!shared)
+        return true;
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    return shared->changed.wait_until(lock, until, [this] { return shared->status != Status::RUNNING; });
+}
+
+SolveHandle::Status SolveHandle::status() const
+{
+    if (!shared)
+        return Status::INVALID_CUBE;
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->status;
+}
+
+bool SolveHandle::hasSolution() const
+{
+    if (!shared)
+        return false;
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->found;
+}
+
+std::vector<Move> SolveHandle::bestSolution() const
+{
+    if (!shared)
+        return {};
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->best;
+}
+
+int SolveHandle::improvements() const
+{
+    if (!shared)
+        return 0;
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->improvements;
+}
+
+AsyncSolver::AsyncSolver(int maxLength, int targetLength, int variants)
+    : maxLength(maxLength), targetLength(targetLength), variants(variants)
+{
+}
+
+static SolveHandle::Status statusFor(SearchOutcome outcome)
+{
+    switch (outcome)
+    {
+    case SearchOutcome::EXHAUSTED:
+        return SolveHandle::Status::EXHAUSTED;
+    case SearchOutcome::TARGET_REACHED:
+        return SolveHandle::Status::TARGET_REACHED;
+    case SearchOutcome::DEADLINE:
+        return SolveHandle::Status::DEADLINE;
+    case SearchOutcome::CANCELLED:
+        return SolveHandle::Status::CANCELLED;
+    case SearchOutcome::INVALID_CUBE:
+        return SolveHandle::Status::INVALID_CUBE;
+    }
+    return SolveHandle::Status::INVALID_CUBE;
+}
+
+SolveHandle AsyncSolver::solve(const CubieCube &cube, std::chrono::steady_clock::time_point deadline)
+{
+    SolveHandle handle;
+    std::shared_ptr<SolveHandle::Shared> shared = std::make_shared<SolveHandle::Shared>();
+    handle.shared = shared;
+
+    TwoPhaseOptions options;
+    options.maxLength = maxLength;
+    options.targetLength = targetLength;
+    options.deadline = deadline;
+    options.cancel = &shared->cancel;
+    options.onSolution = [shared](const std::vector<Move> &solution) {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->best = solution;
+        shared->found = true;
+        shared->improvements++;
+        shared->changed.notify_all();
+    };
+
+    handle.worker = std::thread([shared, cube, options, variants = variants]() {
+        MultiAxisSolver solver(variants);
+        TwoPhaseResult result = solver.solve(cube, options);
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->status = statusFor(result.outcome);
+        shared->changed.notify_all();
+    });
+    return handle;
+}
+
+SolveHandle AsyncSolver::solve(const RubiksCube &cube, std::chrono::steady_clock::time_point deadline)
+{
+    CubieCube cubie;
+    if (!cubie.fromCube(cube))
+    {
+        // Leave the handle finished, with no solution.
+        SolveHandle handle;
+        handle.shared = std::make_shared<SolveHandle::Shared>();
+        handle.shared->status = SolveHandle::Status::INVALID_CUBE;
+        return handle;
+    }
+    return solve(cubie, deadline);
+}
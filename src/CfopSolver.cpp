@@ -0,0 +1,609 @@
+#include "CfopSolver.h"
+#include "Coordinates.h"
+#include "Facelets.h"
+#include "Profiler.h"
+#include <chrono>
+
+// Last-layer algorithms the OLL and PLL tables are built from. Each one
+// leaves the first two layers solved; the PLL ones (all 21) also keep the
+// last layer oriented. The tables combine them, with U turns in between, as
+// needed; OLL, with a 2-look subset, often needs two.
+static const char *const OLL_ALGORITHMS[] = {
+    "R U R' U R U2 R'",
+    "R U2 R' U' R U' R'",
+    "F R U R' U' F'",
+    "F U R U' R' F'",
+    "R U R' U R U' R' U R U2 R'",
+    "R U2 R2 U' R2 U' R2 U2 R",
+    "R U R' U' R' F R F'",
+    "F R U' R' U' R U R' F'",
+    "R U2 R2 F R F' U2 R' F R F'",
+    "R' U' F U R U' R' F' R",
+    "F R U R' U' R U R' U' F'",
+    "R2 D R' U2 R D' R' U2 R'",
+    "R' F R B' R' F' R B",
+    "R U R' U' R' F R2 U R' U' F'",
+    "R U B' U' R' U R B R'",
+    "F U R U2 R' U' R U R' F'",
+};
+
+static const char *const PLL_ALGORITHMS[] = {
+    "R U' R U R U R U' R' U' R2",                   // Ua
+    "R2 U R U R' U' R' U' R' U R'",                 // Ub
+    "R U R' U' R' F R2 U' R' U' R U R' F'",         // T
+    "R' F R' B2 R F' R' B2 R2",                     // Aa
+    "R2 B2 R F R' B2 R F' R",                       // Ab
+    "R U R' F' R U R' U' R' F R2 U' R'",            // Jb
+    "R' U L' U2 R U' R' U2 R L",                    // Ja
+    "F R U' R' U' R U R' F' R U R' U' R' F R F'",   // Y
+    "R' U' F' R U R' U' R' F R2 U' R' U' R U R' U R", // F
+    "R U' R' U' R U R D R' U' R D' R' U2 R'",       // Ra
+    "R2 F R U R U' R' F' R U2 R' U2 R",             // Rb
+    "R' U R' U' B' R' B2 U' B' U B' R B R",         // V
+    "R2 U2 R U2 R2 U2 R2 U2 R U2 R2",               // H
+    "R' U' R U' R U R U' R' U R U R2 U' R'",        // Z
+    "R' U L' D2 L U' R L' U R' D2 R U' L",          // E
+    "L U' R U2 L' U R' L U' R U2 L' U R'",          // Na
+    "R' U L' U2 R U' L R' U L' U2 R U' L",          // Nb
+    "R2 U R' U R' U' R U' R2 D U' R' U R D'",       // Ga
+    "R' U' R U D' R2 U R' U R U' R U' R2 D",        // Gb
+    "R2 U' R U' R U R' U R2 D' U R U' R' D",        // Gc
+    "R U R' U' D R2 U' R U' R' U R' U R2 D'",       // Gd
+};
+
+// Pieces tracked one at a time: an edge as slot * 2 + flip, a corner as
+// slot * 3 + twist.
+static const int PIECE_STATES = 24;
+
+static const int CROSS_STATES = PIECE_STATES * PIECE_STATES * PIECE_STATES * PIECE_STATES;
+static const int PAIR_STATES = PIECE_STATES * PIECE_STATES;
+static const int NUM_SLOTS = 4;
+static const int OLL_STATES = 81 * 16; // four corner twists, four edge flips
+static const int PLL_STATES = 24 * 24; // corner and edge permutations of the U layer
+
+static const uint8_t UNSEEN = 0xFF;
+static const uint16_t NOT_ALLOWED = 0xFFFF;
+
+// The F2L slots FR, FL, BL, BR hold corner DFR + s and edge FR + s.
+static int slotCorner(int slot)
+{
+    return CubieCube::DFR + slot;
+}
+
+static int slotEdge(int slot)
+{
+    return CubieCube::FR + slot;
+}
+
+struct Macro
+{
+    std::vector<Move> moves;
+    CubieCube effect;
+};
+
+// One table entry: moves left to the goal and the macro to apply next.
+struct MacroStep
+{
+    uint8_t distance;
+    uint8_t macro;
+};
+
+struct CfopSolver::Tables
+{
+    uint8_t edgeMove[PIECE_STATES][NUM_MOVES];
+    uint8_t cornerMove[PIECE_STATES][NUM_MOVES];
+
+    // Exact number of moves to solve the cross, by cross index.
+    std::vector<uint8_t> crossDistance;
+
+    std::vector<Macro> f2lMacros;
+    // f2l[(slot * 16 + solvedSlots) * PAIR_STATES + corner * 24 + edge]
+    std::vector<MacroStep> f2l;
+
+    std::vector<Macro> ollMacros;
+    std::vector<MacroStep> oll;
+    std::vector<Macro> pllMacros;
+    std::vector<MacroStep> pll;
+
+    Tables();
+};
+
+static Macro makeMacro(std::vector<Move> moves)
+{
+    Macro macro;
+    macro.moves = std::move(moves);
+    macro.effect.apply(macro.moves.data(), macro.moves.size());
+    return macro;
+}
+
+// The last-layer macros: each algorithm after each of the four U turns, and
+// with `plainTurns` the U turns by themselves.
+static std::vector<Macro> lastLayerMacros(const char *const *algorithms, size_t count, bool plainTurns)
+{
+    std::vector<Macro> macros;
+    for (int k = 1; k <= 3 && plainTurns; k++)
+        macros.push_back(makeMacro({makeMove(0, k)}));
+    for (size_t a = 0; a < count; a++)
+    {
+        std::vector<Move> algorithm;
+        parseAlgorithm(algorithms[a], algorithm);
+        for (int k = 0; k < 4; k++)
+        {
+            std::vector<Move> moves;
+            if (k > 0)
+                moves.push_back(makeMove(0, k));
+            moves.insert(moves.end(), algorithm.begin(), algorithm.end());
+            macros.push_back(makeMacro(moves));
+        }
+    }
+    return macros;
+}
+
+// Cheapest macro sequences from every state to `goal`, counted in moves.
+// next[s * numMacros + m] is where macro m leads from s, or NOT_ALLOWED.
+// Costs differ between macros, so this relaxes until nothing improves
+// rather than searching breadth-first.
+static void buildMacroTable(const std::vector<uint16_t> &next, const std::vector<Macro> &macros, int goal,
+                            MacroStep *steps, int numStates)
+{
+    size_t numMacros = macros.size();
+    for (int s = 0; s < numStates; s++)
+        steps[s] = {UNSEEN, 0};
+    steps[goal].distance = 0;
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int s = 0; s < numStates; s++)
+        {
+            for (size_t m = 0; m < numMacros; m++)
+            {
+                uint16_t to = next[s * numMacros + m];
+                if (to == NOT_ALLOWED || steps[to].distance == UNSEEN)
+                    continue;
+                int distance = steps[to].distance + static_cast<int>(macros[m].moves.size());
+                if (distance < steps[s].distance)
+                {
+                    steps[s] = {static_cast<uint8_t>(distance), static_cast<uint8_t>(m)};
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+static int crossIndex(const uint8_t *edges)
+{
+    return ((edges[0] * PIECE_STATES + edges[1]) * PIECE_STATES + edges[2]) * PIECE_STATES + edges[3];
+}
+
+// Where each piece is, as a piece state.
+static int edgeState(const CubieCube &cube, int edge)
+{
+    int slot = 0;
+    while (cube.ep[slot] != edge)
+        slot++;
+    return slot * 2 + cube.eo[slot];
+}
+
+static int cornerState(const CubieCube &cube, int corner)
+{
+    int slot = 0;
+    while (cube.cp[slot] != corner)
+        slot++;
+    return slot * 3 + cube.co[slot];
+}
+
+static int ollIndex(const uint8_t *twists, const uint8_t *flips)
+{
+    int index = 0;
+    for (int i = 0; i < 4; i++)
+        index = index * 3 + twists[i];
+    for (int i = 0; i < 4; i++)
+        index = index * 2 + flips[i];
+    return index;
+}
+
+static void ollDecode(int index, uint8_t *twists, uint8_t *flips)
+{
+    for (int i = 3; i >= 0; i--, index /= 2)
+        flips[i] = static_cast<uint8_t>(index % 2);
+    for (int i = 3; i >= 0; i--, index /= 3)
+        twists[i] = static_cast<uint8_t>(index % 3);
+}
+
+static int pllIndex(const uint8_t *corners, const uint8_t *edges)
+{
+    return permutationRank(corners, 4) * 24 + permutationRank(edges, 4);
+}
+
+CfopSolver::Tables::Tables()
+{
+    RUBIKS_PROFILE_SCOPE("Cfop::tables");
+    // Where one piece goes under each move: the piece in slot j moves to the
+    // slot i with move.ep[i] == j.
+    for (int m = 0; m < NUM_MOVES; m++)
+    {
+        const CubieCube &move = CubieCube::moveCube(static_cast<Move>(m));
+        for (int i = 0; i < 12; i++)
+        {
+            for (int flip = 0; flip < 2; flip++)
+                edgeMove[move.ep[i] * 2 + flip][m] = static_cast<uint8_t>(i * 2 + (flip ^ move.eo[i]));
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            for (int twist = 0; twist < 3; twist++)
+                cornerMove[move.cp[i] * 3 + twist][m] = static_cast<uint8_t>(i * 3 + (twist + move.co[i]) % 3);
+        }
+    }
+
+    // Cross: breadth-first from the solved cross over all placements of the
+    // four D edges.
+    {
+        crossDistance.assign(CROSS_STATES, UNSEEN);
+        uint8_t solved[4];
+        for (int i = 0; i < 4; i++)
+            solved[i] = static_cast<uint8_t>((CubieCube::DR + i) * 2);
+        std::vector<int> queue(1, crossIndex(solved));
+        crossDistance[queue[0]] = 0;
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            int index = queue[head];
+            uint8_t edges[4] = {static_cast<uint8_t>(index / (24 * 24 * 24)), static_cast<uint8_t>(index / (24 * 24) % 24),
+                                static_cast<uint8_t>(index / 24 % 24), static_cast<uint8_t>(index % 24)};
+            for (int m = 0; m < NUM_MOVES; m++)
+            {
+                uint8_t moved[4];
+                for (int i = 0; i < 4; i++)
+                    moved[i] = edgeMove[edges[i]][m];
+                int child = crossIndex(moved);
+                if (crossDistance[child] == UNSEEN)
+                {
+                    crossDistance[child] = static_cast<uint8_t>(crossDistance[index] + 1);
+                    queue.push_back(child);
+                }
+            }
+        }
+    }
+
+    // F2L macros, and which slots each one disturbs.
+    std::vector<int> disturbs;
+    for (int k = 1; k <= 3; k++)
+        f2lMacros.push_back(makeMacro({makeMove(0, k)}));
+    for (int face = 1; face <= 4; face++)
+    {
+        for (int quarterTurns = 1; quarterTurns <= 3; quarterTurns += 2)
+        {
+            Move x = makeMove(face, quarterTurns);
+            for (int k = 1; k <= 3; k++)
+                f2lMacros.push_back(makeMacro({x, makeMove(0, k), inverse(x)}));
+        }
+    }
+    for (const Macro &macro : f2lMacros)
+    {
+        int mask = 0;
+        for (int slot = 0; slot < NUM_SLOTS; slot++)
+        {
+            const CubieCube &effect = macro.effect;
+            if (effect.cp[slotCorner(slot)] != slotCorner(slot) || effect.co[slotCorner(slot)] != 0 ||
+                effect.ep[slotEdge(slot)] != slotEdge(slot) || effect.eo[slotEdge(slot)] != 0)
+                mask |= 1 << slot;
+        }
+        disturbs.push_back(mask);
+    }
+
+    size_t numMacros = f2lMacros.size();
+    std::vector<uint16_t> pairNext(PAIR_STATES * numMacros);
+    for (int corner = 0; corner < PIECE_STATES; corner++)
+    {
+        for (int edge = 0; edge < PIECE_STATES; edge++)
+        {
+            for (size_t m = 0; m < numMacros; m++)
+            {
+                int c = corner, e = edge;
+                for (Move move : f2lMacros[m].moves)
+                {
+                    c = cornerMove[c][static_cast<int>(move)];
+                    e = edgeMove[e][static_cast<int>(move)];
+                }
+                pairNext[(corner * PIECE_STATES + edge) * numMacros + m] = static_cast<uint16_t>(c * PIECE_STATES + e);
+            }
+        }
+    }
+
+    f2l.resize(NUM_SLOTS * 16 * PAIR_STATES);
+    std::vector<uint16_t> next(pairNext.size());
+    for (int slot = 0; slot < NUM_SLOTS; slot++)
+    {
+        for (int solved = 0; solved < 16; solved++)
+        {
+            if (solved & (1 << slot))
+                continue;
+            for (size_t i = 0; i < next.size(); i++)
+                next[i] = (disturbs[i % numMacros] & solved) ? NOT_ALLOWED : pairNext[i];
+            int goal = slotCorner(slot) * 3 * PIECE_STATES + slotEdge(slot) * 2;
+            buildMacroTable(next, f2lMacros, goal, &f2l[(slot * 16 + solved) * PAIR_STATES], PAIR_STATES);
+        }
+    }
+
+    // OLL: the twists and flips in the U slots after a macro depend only on
+    // those before it.
+    ollMacros = lastLayerMacros(OLL_ALGORITHMS, sizeof(OLL_ALGORITHMS) / sizeof(OLL_ALGORITHMS[0]), false);
+    next.assign(OLL_STATES * ollMacros.size(), 0);
+    for (int s = 0; s < OLL_STATES; s++)
+    {
+        uint8_t twists[4], flips[4];
+        ollDecode(s, twists, flips);
+        for (size_t m = 0; m < ollMacros.size(); m++)
+        {
+            const CubieCube &effect = ollMacros[m].effect;
+            uint8_t newTwists[4], newFlips[4];
+            for (int i = 0; i < 4; i++)
+            {
+                newTwists[i] = static_cast<uint8_t>((twists[effect.cp[i]] + effect.co[i]) % 3);
+                newFlips[i] = static_cast<uint8_t>(flips[effect.ep[i]] ^ effect.eo[i]);
+            }
+            next[s * ollMacros.size() + m] = static_cast<uint16_t>(ollIndex(newTwists, newFlips));
+        }
+    }
+    oll.resize(OLL_STATES);
+    buildMacroTable(next, ollMacros, 0, oll.data(), OLL_STATES);
+
+    // PLL: likewise for the permutation of the U slots.
+    pllMacros = lastLayerMacros(PLL_ALGORITHMS, sizeof(PLL_ALGORITHMS) / sizeof(PLL_ALGORITHMS[0]), true);
+    next.assign(PLL_STATES * pllMacros.size(), 0);
+    for (int s = 0; s < PLL_STATES; s++)
+    {
+        uint8_t corners[4], edges[4];
+        permutationUnrank(s / 24, corners, 4);
+        permutationUnrank(s % 24, edges, 4);
+        for (size_t m = 0; m < pllMacros.size(); m++)
+        {
+            const CubieCube &effect = pllMacros[m].effect;
+            uint8_t newCorners[4], newEdges[4];
+            for (int i = 0; i < 4; i++)
+            {
+                newCorners[i] = corners[effect.cp[i]];
+                newEdges[i] = edges[effect.ep[i]];
+            }
+            next[s * pllMacros.size() + m] = static_cast<uint16_t>(pllIndex(newCorners, newEdges));
+        }
+    }
+    pll.resize(PLL_STATES);
+    buildMacroTable(next, pllMacros, 0, pll.data(), PLL_STATES);
+}
+
+const CfopSolver::Tables &CfopSolver::tables()
+{
+    static const Tables shared;
+    return shared;
+}
+
+void CfopSolver::prepareTables()
+{
+    tables();
+}
+
+size_t CfopSolver::tableBytes()
+{
+    const Tables &t = tables();
+    size_t bytes = sizeof(Tables) + t.crossDistance.size() + (t.f2l.size() + t.oll.size() + t.pll.size()) * sizeof(MacroStep);
+    for (const std::vector<Macro> *macros : {&t.f2lMacros, &t.ollMacros, &t.pllMacros})
+    {
+        for (const Macro &macro : *macros)
+            bytes += sizeof(Macro) + macro.moves.size() * sizeof(Move);
+    }
+    return bytes;
+}
+
+CfopSolver::CfopSolver() : t(tables())
+{
+}
+
+const char *cfopStageName(CfopStage stage)
+{
+    static const char *const names[NUM_CFOP_STAGES] = {"cross", "F2L", "OLL", "PLL"};
+    return names[static_cast<int>(stage)];
+}
+
+int CfopSolver::ollPattern(const RubiksCube::Color *stickers)
+{
+    const RubiksCube::Color up = RubiksCube::Color::WHITE;
+    uint8_t twists[4], flips[4];
+    for (int i = 0; i < 4; i++)
+    {
+        int twist = 0;
+        while (twist < 3 && stickers[CubieCube::CORNER_FACELETS[i][twist]] != up)
+            twist++;
+        if (twist == 3)
+            return -1;
+        twists[i] = static_cast<uint8_t>(twist);
+
+        if (stickers[CubieCube::EDGE_FACELETS[i][0]] == up)
+            flips[i] = 0;
+        else if (stickers[CubieCube::EDGE_FACELETS[i][1]] == up)
+            flips[i] = 1;
+        else
+            return -1;
+    }
+    return ollIndex(twists, flips);
+}
+
+int CfopSolver::pllPattern(const RubiksCube::Color *stickers)
+{
+    // A top-layer piece is told apart by its side colors; with the U color on
+    // top, the corner's first side sticker and the edge's side sticker are
+    // enough.
+    const RubiksCube::Color up = RubiksCube::Color::WHITE;
+    uint8_t corners[4], edges[4];
+    int seenCorners = 0, seenEdges = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (stickers[CubieCube::CORNER_FACELETS[i][0]] != up || stickers[CubieCube::EDGE_FACELETS[i][0]] != up)
+            return -1;
+        int corner = 0;
+        while (corner < 4 && stickers[CubieCube::CORNER_FACELETS[i][1]] !=
+                                 static_cast<RubiksCube::Color>(CubieCube::CORNER_FACELETS[corner][1] / 9))
+            corner++;
+        int edge = 0;
+        while (edge < 4 && stickers[CubieCube::EDGE_FACELETS[i][1]] !=
+                               static_cast<RubiksCube::Color>(CubieCube::EDGE_FACELETS[edge][1] / 9))
+            edge++;
+        if (corner == 4 || edge == 4 || (seenCorners & (1 << corner)) || (seenEdges & (1 << edge)))
+            return -1;
+        seenCorners |= 1 << corner;
+        seenEdges |= 1 << edge;
+        corners[i] = static_cast<uint8_t>(corner);
+        edges[i] = static_cast<uint8_t>(edge);
+    }
+    return pllIndex(corners, edges);
+}
+
+// IDA* on the four cross edges. The distance table is exact, so the first
+// iteration already succeeds and only moves that get closer are followed.
+static bool crossSearch(const uint8_t (&edgeMove)[PIECE_STATES][NUM_MOVES], const std::vector<uint8_t> &distance,
+                        const uint8_t *edges, int g, int bound, int lastFace, std::vector<Move> &moves)
+{
+    int h = distance[crossIndex(edges)];
+    if (g + h > bound)
+        return false;
+    if (h == 0)
+        return true;
+    for (int m = 0; m < NUM_MOVES; m++)
+    {
+        int face = m / 3;
+        if (!isCanonicalAfter(face, lastFace))
+            continue;
+        uint8_t moved[4];
+        for (int i = 0; i < 4; i++)
+            moved[i] = edgeMove[edges[i]][m];
+        moves.push_back(static_cast<Move>(m));
+        if (crossSearch(edgeMove, distance, moved, g + 1, bound, face, moves))
+            return true;
+        moves.pop_back();
+    }
+    return false;
+}
+
+// Applies the macros a table names until it reaches its goal.
+static bool walkMacros(const MacroStep *table, const std::vector<Macro> &macros, int state, CubieCube &cube,
+                       std::vector<Move> &moves, int (*stateOf)(const CubieCube &, int), int arg)
+{
+    while (table[state].distance != 0)
+    {
+        if (table[state].distance == UNSEEN)
+            return false;
+        const Macro &macro = macros[table[state].macro];
+        moves.insert(moves.end(), macro.moves.begin(), macro.moves.end());
+        cube.multiply(macro.effect);
+        state = stateOf(cube, arg);
+        if (state < 0)
+            return false;
+    }
+    return true;
+}
+
+static int pairState(const CubieCube &cube, int slot)
+{
+    return cornerState(cube, slotCorner(slot)) * PIECE_STATES + edgeState(cube, slotEdge(slot));
+}
+
+static int lastLayerPattern(const CubieCube &cube, int permutation)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.toStickers(stickers);
+    return permutation ? CfopSolver::pllPattern(stickers) : CfopSolver::ollPattern(stickers);
+}
+
+bool CfopSolver::solve(const CubieCube &cube, CfopResult &result) const
+{
+    result = CfopResult();
+    if (validateCubie(cube) != FaceletError::NONE)
+        return false;
+
+    CubieCube state = cube;
+    auto stageStart = std::chrono::steady_clock::now();
+    auto finishStage = [&](CfopStage stage) {
+        auto now = std::chrono::steady_clock::now();
+        CfopStageResult &stageResult = result.stages[static_cast<int>(stage)];
+        stageResult.micros = std::chrono::duration<double, std::micro>(now - stageStart).count();
+        stageResult.moves.resize(simplifyMoves(stageResult.moves.data(), stageResult.moves.size()));
+        stageStart = now;
+    };
+
+    {
+        RUBIKS_PROFILE_SCOPE("Cfop::cross");
+        std::vector<Move> &moves = result.stages[static_cast<int>(CfopStage::CROSS)].moves;
+        uint8_t edges[4];
+        for (int i = 0; i < 4; i++)
+            edges[i] = static_cast<uint8_t>(edgeState(state, CubieCube::DR + i));
+        for (int bound = t.crossDistance[crossIndex(edges)]; !crossSearch(t.edgeMove, t.crossDistance, edges, 0, bound, -1, moves);
+             bound++)
+        {
+        }
+        state.apply(moves.data(), moves.size());
+        finishStage(CfopStage::CROSS);
+    }
+
+    {
+        RUBIKS_PROFILE_SCOPE("Cfop::f2l");
+        std::vector<Move> &moves = result.stages[static_cast<int>(CfopStage::F2L)].moves;
+        int solved = 0;
+        while (solved != 15)
+        {
+            // Each slot's table allows only macros that keep the others.
+            int best = -1, bestDistance = 0;
+            for (int slot = 0; slot < NUM_SLOTS; slot++)
+            {
+                if (solved & (1 << slot))
+                    continue;
+                int distance = t.f2l[(slot * 16 + solved) * PAIR_STATES + pairState(state, slot)].distance;
+                if (best < 0 || distance < bestDistance)
+                {
+                    best = slot;
+                    bestDistance = distance;
+                }
+            }
+            const MacroStep *table = &t.f2l[(best * 16 + solved) * PAIR_STATES];
+            if (!walkMacros(table, t.f2lMacros, pairState(state, best), state, moves, pairState, best))
+                return false;
+            solved |= 1 << best;
+        }
+        finishStage(CfopStage::F2L);
+    }
+
+    {
+        RUBIKS_PROFILE_SCOPE("Cfop::oll");
+        std::vector<Move> &moves = result.stages[static_cast<int>(CfopStage::OLL)].moves;
+        int pattern = lastLayerPattern(state, 0);
+        if (pattern < 0 || !walkMacros(t.oll.data(), t.ollMacros, pattern, state, moves, lastLayerPattern, 0))
+            return false;
+        finishStage(CfopStage::OLL);
+    }
+
+    {
+        RUBIKS_PROFILE_SCOPE("Cfop::pll");
+        std::vector<Move> &moves = result.stages[static_cast<int>(CfopStage::PLL)].moves;
+        int pattern = lastLayerPattern(state, 1);
+        if (pattern < 0 || !walkMacros(t.pll.data(), t.pllMacros, pattern, state, moves, lastLayerPattern, 1))
+            return false;
+        finishStage(CfopStage::PLL);
+    }
+
+    for (const CfopStageResult &stage : result.stages)
+        result.solution.insert(result.solution.end(), stage.moves.begin(), stage.moves.end());
+    result.solution.resize(simplifyMoves(result.solution.data(), result.solution.size()));
+    return state.isSolved();
+}
+
+bool CfopSolver::solve(const RubiksCube &cube, CfopResult &result) const
+{
+    CubieCube cubie;
+    if (!cubie.fromCube(cube))
+    {
+        result = CfopResult();
+        return false;
+    }
+    return solve(cubie, result);
+}
@@ -0,0 +1,173 @@
+#include "Coordinates.h"
+
+int binomial(int n, int k)
+{
+    if (k < 0 || k > n)
+        return 0;
+    int result = 1;
+    for (int i = 1; i <= k; i++)
+        result = result * (n - k + i) / i;
+    return result;
+}
+
+int permutationRank(const uint8_t *perm, int n)
+{
+    int rank = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int smaller = 0;
+        for (int j = i + 1; j < n; j++)
+        {
+            if (perm[j] < perm[i])
+                smaller++;
+        }
+        rank = rank * (n - i) + smaller;
+    }
+    return rank;
+}
+
+void permutationUnrank(int rank, uint8_t *perm, int n)
+{
+    // Digits of the factorial-base rank, least significant last.
+    int digits[12];
+    for (int i = n - 1; i >= 0; i--)
+    {
+        digits[i] = rank % (n - i);
+        rank /= n - i;
+    }
+    bool used[12] = {false};
+    for (int i = 0; i < n; i++)
+    {
+        // The digit counts how many unused values the entry skips.
+        int skip = digits[i];
+        int value = 0;
+        for (;; value++)
+        {
+            if (used[value])
+                continue;
+            if (skip-- == 0)
+                break;
+        }
+        used[value] = true;
+        perm[i] = static_cast<uint8_t>(value);
+    }
+}
+
+int twistCoord(const CubieCube &cube)
+{
+    int twist = 0;
+    for (int i = 0; i < 7; i++)
+        twist = twist * 3 + cube.co[i];
+    return twist;
+}
+
+void setTwistCoord(CubieCube &cube, int twist)
+{
+    int sum = 0;
+    for (int i = 6; i >= 0; i--)
+    {
+        cube.co[i] = static_cast<uint8_t>(twist % 3);
+        sum += cube.co[i];
+        twist /= 3;
+    }
+    cube.co[7] = static_cast<uint8_t>((3 - sum % 3) % 3);
+}
+
+int flipCoord(const CubieCube &cube)
+{
+    int flip = 0;
+    for (int i = 0; i < 11; i++)
+        flip = flip * 2 + cube.eo[i];
+    return flip;
+}
+
+void setFlipCoord(CubieCube &cube, int flip)
+{
+    int sum = 0;
+    for (int i = 10; i >= 0; i--)
+    {
+        cube.eo[i] = static_cast<uint8_t>(flip & 1);
+        sum += cube.eo[i];
+        flip >>= 1;
+    }
+    cube.eo[11] = static_cast<uint8_t>(sum & 1);
+}
+
+static bool isSliceEdge(uint8_t edge)
+{
+    return edge >= CubieCube::FR;
+}
+
+// Combinatorial number system over the slots counted from BR downwards, so
+// the solved slots (FR FL BL BR) get 0.
+int sliceCoord(const CubieCube &cube)
+{
+    int slice = 0;
+    int found = 0;
+    for (int slot = 11; slot >= 0; slot--)
+    {
+        if (isSliceEdge(cube.ep[slot]))
+        {
+            found++;
+            slice += binomial(11 - slot, found);
+        }
+    }
+    return slice;
+}
+
+void setSliceCoord(CubieCube &cube, int slice)
+{
+    bool inSlice[12] = {false};
+    for (int k = 4; k >= 1; k--)
+    {
+        int c = k - 1;
+        while (binomial(c + 1, k) <= slice)
+            c++;
+        slice -= binomial(c, k);
+        inSlice[11 - c] = true;
+    }
+
+    uint8_t nextSlice = CubieCube::FR, nextOther = CubieCube::UR;
+    for (int slot = 0; slot < 12; slot++)
+        cube.ep[slot] = inSlice[slot] ? nextSlice++ : nextOther++;
+}
+
+int cornerPermCoord(const CubieCube &cube)
+{
+    return permutationRank(cube.cp, 8);
+}
+
+void setCornerPermCoord(CubieCube &cube, int perm)
+{
+    permutationUnrank(perm, cube.cp, 8);
+}
+
+int udEdgePermCoord(const CubieCube &cube)
+{
+    return permutationRank(cube.ep, 8);
+}
+
+void setUdEdgePermCoord(CubieCube &cube, int perm)
+{
+    permutationUnrank(perm, cube.ep, 8);
+    for (int slot = 8; slot < 12; slot++)
+        cube.ep[slot] = static_cast<uint8_t>(slot);
+}
+
+int slicePermCoord(const CubieCube &cube)
+{
+    uint8_t perm[4];
+    for (int i = 0; i < 4; i++)
+        perm[i] = static_cast<uint8_t>(cube.ep[8 + i] - 8);
+    return permutationRank(perm, 4);
+}
+
+void setSlicePermCoord(CubieCube &cube, int perm)
+{
+    uint8_t slicePerm[4];
+    permutationUnrank(perm, slicePerm, 4);
+    for (int slot = 0; slot < 8; slot++)
+        cube.ep[slot] = static_cast<uint8_t>(slot);
+    for (int i = 0; i < 4; i++)
+        cube.ep[8 + i] = static_cast<uint8_t>(8 + slicePerm[i]);
+}
@@ -0,0 +1,143 @@
+#include "CubeRenderer.h"
+#include "Facelets.h"
+
+// Letter of each color, indexed by RubiksCube::Color.
+static const char COLOR_LETTERS[6] = {'W', 'G', 'R', 'B', 'O', 'Y'};
+
+// Line widths of a net, newline included: "        X X X " for U and D,
+// "X X X   X X X   X X X   X X X " for the middle band.
+static constexpr size_t NET_SIDE_LINE = 15;
+static constexpr size_t NET_BAND_LINE = 31;
+static constexpr size_t NET_SIZE = 6 * NET_SIDE_LINE + 3 * NET_BAND_LINE + 2;
+static constexpr size_t COMPACT_SIZE = RubiksCube::NUM_STICKERS + 5 + 1;
+
+// Writes one row of a face as "X X X ".
+static char *writeRow(char *out, const RubiksCube::Color *stickers, int face, int row)
+{
+    const RubiksCube::Color *s = stickers + face * 9 + row * 3;
+    for (int col = 0; col < 3; col++)
+    {
+        *out++ = COLOR_LETTERS[static_cast<int>(s[col])];
+        *out++ = ' ';
+    }
+    return out;
+}
+
+static char *writeSideFace(char *out, const RubiksCube::Color *stickers, int face)
+{
+    for (int row = 0; row < 3; row++)
+    {
+        for (int i = 0; i < 8; i++)
+            *out++ = ' ';
+        out = writeRow(out, stickers, face, row);
+        *out++ = '\n';
+    }
+    return out;
+}
+
+static char *writeNet(char *out, const RubiksCube::Color *stickers)
+{
+    out = writeSideFace(out, stickers, static_cast<int>(RubiksCube::Face::UP));
+    *out++ = '\n';
+    for (int row = 0; row < 3; row++)
+    {
+        // LEFT, FRONT, RIGHT and BACK side by side.
+        for (int face = 1; face <= 4; face++)
+        {
+            out = writeRow(out, stickers, face, row);
+            if (face < 4)
+            {
+                *out++ = ' ';
+                *out++ = ' ';
+            }
+        }
+        *out++ = '\n';
+    }
+    *out++ = '\n';
+    return writeSideFace(out, stickers, static_cast<int>(RubiksCube::Face::DOWN));
+}
+
+static char *writeCompact(char *out, const RubiksCube::Color *stickers)
+{
+    for (int face = 0; face < 6; face++)
+    {
+        if (face > 0)
+            *out++ = ' ';
+        for (int i = 0; i < 9; i++)
+            *out++ = COLOR_LETTERS[static_cast<int>(stickers[face * 9 + i])];
+    }
+    *out++ = '\n';
+    return out;
+}
+
+CubeRenderer::CubeRenderer(std::string &buffer, RenderFormat format) : buffer(buffer), format(format)
+{
+}
+
+size_t CubeRenderer::renderedSize(RenderFormat format)
+{
+    switch (format)
+    {
+    case RenderFormat::NET:
+        return NET_SIZE + 1;
+    case RenderFormat::FACELETS:
+        return RubiksCube::NUM_STICKERS + 1;
+    case RenderFormat::COMPACT:
+        return COMPACT_SIZE;
+    }
+    return 0;
+}
+
+void CubeRenderer::add(const RubiksCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.getStickers(stickers);
+    add(stickers);
+}
+
+void CubeRenderer::add(const CubieCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.toStickers(stickers);
+    add(stickers);
+}
+
+void CubeRenderer::add(const RubiksCube::Color *stickers)
+{
+    // Grow once to the exact size and write straight into the string.
+    size_t start = buffer.size();
+    bool separate = format == RenderFormat::NET && added > 0;
+    size_t size = format == RenderFormat::NET ? NET_SIZE + separate : renderedSize(format);
+    buffer.resize(start + size);
+    char *out = &buffer[start];
+    switch (format)
+    {
+    case RenderFormat::NET:
+        if (separate)
+            *out++ = '\n';
+        writeNet(out, stickers);
+        break;
+    case RenderFormat::FACELETS:
+        writeFacelets(stickers, out);
+        out[RubiksCube::NUM_STICKERS] = '\n';
+        break;
+    case RenderFormat::COMPACT:
+        writeCompact(out, stickers);
+        break;
+    }
+    added++;
+}
+
+void CubeRenderer::reserve(size_t count)
+{
+    buffer.reserve(buffer.size() + count * renderedSize(format));
+}
+
+bool CubeRenderer::flush(std::ostream &out)
+{
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();
+    added = 0;
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,111 @@
+#include "CubeTransform.h"
+#include <cstring>
+
+CubeTransform::CubeTransform()
+{
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        source[i] = static_cast<uint8_t>(i);
+    }
+}
+
+CubeTransform CubeTransform::fromMove(Move m)
+{
+    CubeTransform t;
+    int quarterTurns = moveQuarterTurns(m);
+    const int(*cycles)[4] = RubiksCube::STICKER_CYCLES[moveFace(m)];
+    for (int i = 0; i < 5; i++)
+    {
+        // A clockwise quarter turn moves c[k + 1] onto c[k]; k quarter turns
+        // move c[k + quarterTurns].
+        for (int k = 0; k < 4; k++)
+        {
+            t.source[cycles[i][k]] = static_cast<uint8_t>(cycles[i][(k + quarterTurns) & 3]);
+        }
+    }
+    return t;
+}
+
+CubeTransform CubeTransform::fromMoves(const Move *moves, size_t count)
+{
+    CubeTransform t;
+    for (size_t i = 0; i < count; i++)
+    {
+        t = t.then(fromMove(moves[i]));
+    }
+    return t;
+}
+
+CubeTransform CubeTransform::then(const CubeTransform &next) const
+{
+    CubeTransform result;
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        result.source[i] = source[next.source[i]];
+    }
+    return result;
+}
+
+CubeTransform CubeTransform::inverse() const
+{
+    CubeTransform result;
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        result.source[source[i]] = static_cast<uint8_t>(i);
+    }
+    return result;
+}
+
+CubeTransform CubeTransform::power(int n) const
+{
+    // Exponentiation by squaring; powers of one permutation commute, so the
+    // order of composition does not matter.
+    CubeTransform base = n < 0 ? inverse() : *this;
+    unsigned int e = n < 0 ? static_cast<unsigned int>(-(n + 1)) + 1 : static_cast<unsigned int>(n);
+    CubeTransform result;
+    while (e > 0)
+    {
+        if (e & 1)
+            result = result.then(base);
+        base = base.then(base);
+        e >>= 1;
+    }
+    return result;
+}
+
+void CubeTransform::applyTo(RubiksCube::Color *stickers) const
+{
+    RubiksCube::Color before[RubiksCube::NUM_STICKERS];
+    std::memcpy(before, stickers, sizeof(before));
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        stickers[i] = before[source[i]];
+    }
+}
+
+void CubeTransform::applyTo(RubiksCube &cube) const
+{
+    RubiksCube::Color before[RubiksCube::NUM_STICKERS];
+    RubiksCube::Color after[RubiksCube::NUM_STICKERS];
+    cube.getStickers(before);
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        after[i] = before[source[i]];
+    }
+    cube.setStickers(after);
+}
+
+bool CubeTransform::isIdentity() const
+{
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        if (source[i] != i)
+            return false;
+    }
+    return true;
+}
+
+bool CubeTransform::operator==(const CubeTransform &other) const
+{
+    return std::memcmp(source, other.source, sizeof(source)) == 0;
+}
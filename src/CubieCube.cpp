@@ -0,0 +1,253 @@
+#include "CubieCube.h"
+#include "CubeTransform.h"
+#include <cstring>
+
+const int CubieCube::CORNER_FACELETS[8][3] = {
+    {8, 27, 20},  // URF: U, R, F
+    {6, 18, 11},  // UFL: U, F, L
+    {0, 9, 38},   // ULB: U, L, B
+    {2, 36, 29},  // UBR: U, B, R
+    {47, 26, 33}, // DFR: D, F, R
+    {45, 17, 24}, // DLF: D, L, F
+    {51, 44, 15}, // DBL: D, B, L
+    {53, 35, 42}  // DRB: D, R, B
+};
+
+const int CubieCube::EDGE_FACELETS[12][2] = {
+    {5, 28},  // UR
+    {7, 19},  // UF
+    {3, 10},  // UL
+    {1, 37},  // UB
+    {50, 34}, // DR
+    {46, 25}, // DF
+    {48, 16}, // DL
+    {52, 43}, // DB
+    {23, 30}, // FR
+    {21, 14}, // FL
+    {41, 12}, // BL
+    {39, 32}  // BR
+};
+
+// In the solved state every sticker has the color of its face.
+static inline RubiksCube::Color solvedColor(int sticker)
+{
+    return static_cast<RubiksCube::Color>(sticker / 9);
+}
+
+CubieCube::CubieCube()
+{
+    for (int i = 0; i < 8; i++)
+    {
+        cp[i] = static_cast<uint8_t>(i);
+        co[i] = 0;
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        ep[i] = static_cast<uint8_t>(i);
+        eo[i] = 0;
+    }
+}
+
+const CubieCube &CubieCube::moveCube(Move m)
+{
+    // Derived once from the sticker cycles, so the cubie moves can never
+    // disagree with the sticker models.
+    static const struct MoveTable
+    {
+        CubieCube moves[NUM_MOVES];
+        MoveTable()
+        {
+            for (int i = 0; i < NUM_MOVES; i++)
+            {
+                RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+                CubieCube().toStickers(stickers);
+                CubeTransform::fromMove(static_cast<Move>(i)).applyTo(stickers);
+                moves[i].fromStickers(stickers);
+            }
+        }
+    } table;
+    return table.moves[static_cast<int>(m)];
+}
+
+void CubieCube::multiply(const CubieCube &other)
+{
+    // Sum of two twists mod 3, without a division in the hot path.
+    static const uint8_t twistSum[5] = {0, 1, 2, 0, 1};
+
+    uint8_t newCp[8], newCo[8], newEp[12], newEo[12];
+    for (int i = 0; i < 8; i++)
+    {
+        newCp[i] = cp[other.cp[i]];
+        newCo[i] = twistSum[co[other.cp[i]] + other.co[i]];
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        newEp[i] = ep[other.ep[i]];
+        newEo[i] = static_cast<uint8_t>(eo[other.ep[i]] ^ other.eo[i]);
+    }
+    std::memcpy(cp, newCp, sizeof(cp));
+    std::memcpy(co, newCo, sizeof(co));
+    std::memcpy(ep, newEp, sizeof(ep));
+    std::memcpy(eo, newEo, sizeof(eo));
+}
+
+void CubieCube::move(Move m)
+{
+    multiply(moveCube(m));
+}
+
+void CubieCube::apply(const Move *moves, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        multiply(moveCube(moves[i]));
+    }
+}
+
+CubieCube CubieCube::inverse() const
+{
+    CubieCube result;
+    for (int i = 0; i < 8; i++)
+    {
+        result.cp[cp[i]] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        result.co[i] = static_cast<uint8_t>((3 - co[result.cp[i]]) % 3);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        result.ep[ep[i]] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        result.eo[i] = eo[result.ep[i]];
+    }
+    return result;
+}
+
+bool CubieCube::isSolved() const
+{
+    return *this == CubieCube();
+}
+
+bool CubieCube::operator==(const CubieCube &other) const
+{
+    return std::memcmp(cp, other.cp, sizeof(cp)) == 0 && std::memcmp(co, other.co, sizeof(co)) == 0 &&
+           std::memcmp(ep, other.ep, sizeof(ep)) == 0 && std::memcmp(eo, other.eo, sizeof(eo)) == 0;
+}
+
+// Counts inversions; the parity of the count is the permutation's parity.
+static int permutationParity(const uint8_t *perm, int n)
+{
+    int inversions = 0;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = i + 1; j < n; j++)
+        {
+            if (perm[i] > perm[j])
+                inversions++;
+        }
+    }
+    return inversions & 1;
+}
+
+int CubieCube::cornerParity() const
+{
+    return permutationParity(cp, 8);
+}
+
+int CubieCube::edgeParity() const
+{
+    return permutationParity(ep, 12);
+}
+
+void CubieCube::toStickers(RubiksCube::Color *stickers) const
+{
+    for (int face = 0; face < 6; face++)
+    {
+        stickers[face * 9 + 4] = static_cast<RubiksCube::Color>(face);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        for (int n = 0; n < 3; n++)
+        {
+            stickers[CORNER_FACELETS[i][(n + co[i]) % 3]] = solvedColor(CORNER_FACELETS[cp[i]][n]);
+        }
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        for (int n = 0; n < 2; n++)
+        {
+            stickers[EDGE_FACELETS[i][(n + eo[i]) % 2]] = solvedColor(EDGE_FACELETS[ep[i]][n]);
+        }
+    }
+}
+
+bool CubieCube::fromStickers(const RubiksCube::Color *stickers)
+{
+    const RubiksCube::Color up = RubiksCube::Color::WHITE;
+    const RubiksCube::Color down = RubiksCube::Color::YELLOW;
+
+    for (int i = 0; i < 8; i++)
+    {
+        // The orientation is the position of the U or D colored sticker.
+        int ori = 0;
+        while (ori < 3 && stickers[CORNER_FACELETS[i][ori]] != up && stickers[CORNER_FACELETS[i][ori]] != down)
+            ori++;
+        if (ori == 3)
+            return false;
+
+        RubiksCube::Color col1 = stickers[CORNER_FACELETS[i][(ori + 1) % 3]];
+        RubiksCube::Color col2 = stickers[CORNER_FACELETS[i][(ori + 2) % 3]];
+        int j = 0;
+        while (j < 8 && !(col1 == solvedColor(CORNER_FACELETS[j][1]) && col2 == solvedColor(CORNER_FACELETS[j][2]) &&
+                          stickers[CORNER_FACELETS[i][ori]] == solvedColor(CORNER_FACELETS[j][0])))
+            j++;
+        if (j == 8)
+            return false;
+
+        cp[i] = static_cast<uint8_t>(j);
+        co[i] = static_cast<uint8_t>(ori);
+    }
+
+    for (int i = 0; i < 12; i++)
+    {
+        RubiksCube::Color a = stickers[EDGE_FACELETS[i][0]];
+        RubiksCube::Color b = stickers[EDGE_FACELETS[i][1]];
+        int j = 0;
+        for (; j < 12; j++)
+        {
+            RubiksCube::Color first = solvedColor(EDGE_FACELETS[j][0]);
+            RubiksCube::Color second = solvedColor(EDGE_FACELETS[j][1]);
+            if (a == first && b == second)
+            {
+                eo[i] = 0;
+                break;
+            }
+            if (a == second && b == first)
+            {
+                eo[i] = 1;
+                break;
+            }
+        }
+        if (j == 12)
+            return false;
+        ep[i] = static_cast<uint8_t>(j);
+    }
+    return true;
+}
+
+bool CubieCube::fromCube(const RubiksCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.getStickers(stickers);
+    return fromStickers(stickers);
+}
+
+void CubieCube::toCube(RubiksCube &cube) const
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    toStickers(stickers);
+    cube.setStickers(stickers);
+}
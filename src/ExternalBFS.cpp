@@ -0,0 +1,254 @@
+#include "ExternalBFS.h"
+#include "Profiler.h"
+#include "StateFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <queue>
+#include <sstream>
+#include <sys/stat.h>
+
+ExternalBFS::ExternalBFS(const std::string &directory, size_t memoryStates)
+    : directory(directory), memoryStates(std::max<size_t>(memoryStates, NUM_MOVES))
+{
+}
+
+std::string ExternalBFS::layerPath(int depth) const
+{
+    return directory + "/layer_" + std::to_string(depth) + ".bin";
+}
+
+std::string ExternalBFS::runPath(int depth, size_t run) const
+{
+    return directory + "/run_" + std::to_string(depth) + "_" + std::to_string(run) + ".bin";
+}
+
+std::string ExternalBFS::manifestPath() const
+{
+    return directory + "/manifest.txt";
+}
+
+// Manifest format: a comment line, then "depth count generated seconds" for
+// each completed layer.
+bool ExternalBFS::loadManifest()
+{
+    completed.clear();
+    std::ifstream in(manifestPath());
+    if (!in)
+        return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        BfsLayer layer;
+        if (!(fields >> layer.depth >> layer.count >> layer.generated >> layer.seconds) ||
+            layer.depth != static_cast<int>(completed.size()))
+        {
+            completed.clear();
+            return false;
+        }
+        completed.push_back(layer);
+    }
+
+    // Resuming needs the last two layers, exactly as recorded.
+    size_t needed = std::min<size_t>(completed.size(), 2);
+    for (size_t i = completed.size() - needed; i < completed.size(); i++)
+    {
+        StateFileReader reader;
+        if (!reader.open(layerPath(static_cast<int>(i))) || reader.size() != completed[i].count)
+        {
+            completed.clear();
+            return false;
+        }
+    }
+    return !completed.empty();
+}
+
+// Writes the manifest to a temporary file and renames it into place, so an
+// interrupted run never leaves a partial manifest behind.
+bool ExternalBFS::saveManifest() const
+{
+    std::string temporary = manifestPath() + ".tmp";
+    {
+        std::ofstream out(temporary);
+        out << "# depth count generated seconds\n";
+        for (const BfsLayer &layer : completed)
+            out << layer.depth << ' ' << layer.count << ' ' << layer.generated << ' ' << layer.seconds << '\n';
+        if (!out.flush())
+            return false;
+    }
+    return std::rename(temporary.c_str(), manifestPath().c_str()) == 0;
+}
+
+bool ExternalBFS::writeRun(std::vector<PackedState> &buffer, int depth, size_t run)
+{
+    RUBIKS_PROFILE_SCOPE("ExternalBFS::writeRun");
+    std::sort(buffer.begin(), buffer.end());
+    buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+
+    StateFileWriter writer;
+    if (!writer.create(runPath(depth, run), 0))
+        return false;
+    for (const PackedState &state : buffer)
+    {
+        if (!writer.append(state))
+            return false;
+    }
+    buffer.clear();
+    return writer.close();
+}
+
+// Walks a sorted layer alongside the merge output to filter out its states.
+struct LayerFilter
+{
+    StateFileReader reader;
+    size_t next = 0;
+
+    bool contains(const PackedState &state)
+    {
+        while (next < reader.size() && reader[next].state() < state)
+            next++;
+        return next < reader.size() && reader[next].state() == state;
+    }
+};
+
+bool ExternalBFS::buildLayer(int depth, BfsLayer &layer)
+{
+    auto start = std::chrono::steady_clock::now();
+    layer = BfsLayer{depth, 0, 0, 0};
+
+    // Expand the previous layer into sorted runs.
+    StateFileReader parents;
+    if (!parents.open(layerPath(depth - 1)))
+        return false;
+
+    std::vector<PackedState> buffer;
+    buffer.reserve(memoryStates);
+    size_t runs = 0;
+    for (StateRecordView parent : parents)
+    {
+        if (buffer.size() + NUM_MOVES > memoryStates)
+        {
+            if (!writeRun(buffer, depth, runs++))
+                return false;
+        }
+        RUBIKS_PROFILE_SCOPE("ExternalBFS::expand");
+        CubieCube cube = unpackState(parent.state());
+        for (int m = 0; m < NUM_MOVES; m++)
+        {
+            CubieCube child = cube;
+            child.move(static_cast<Move>(m));
+            buffer.push_back(packState(child));
+        }
+        layer.generated += NUM_MOVES;
+    }
+    if (!buffer.empty() && !writeRun(buffer, depth, runs++))
+        return false;
+    std::vector<PackedState>().swap(buffer);
+    parents.close();
+
+    // Merge the runs, dropping duplicates and states of the two layers before.
+    RUBIKS_PROFILE_SCOPE("ExternalBFS::merge");
+    std::vector<StateFileReader> readers(runs);
+    std::vector<size_t> positions(runs, 0);
+    typedef std::pair<PackedState, size_t> Head;
+    auto later = [](const Head &a, const Head &b) { return b.first < a.first; };
+    std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+    for (size_t r = 0; r < runs; r++)
+    {
+        if (!readers[r].open(runPath(depth, r)))
+            return false;
+        if (readers[r].size() > 0)
+            heads.push(Head(readers[r][0].state(), r));
+    }
+
+    LayerFilter previous, beforePrevious;
+    if (!previous.reader.open(layerPath(depth - 1)))
+        return false;
+    if (depth >= 2 && !beforePrevious.reader.open(layerPath(depth - 2)))
+        return false;
+
+    StateFileWriter output;
+    if (!output.create(layerPath(depth), 0))
+        return false;
+
+    bool haveLast = false;
+    PackedState last = {0, 0};
+    while (!heads.empty())
+    {
+        Head head = heads.top();
+        heads.pop();
+        size_t r = head.second;
+        if (++positions[r] < readers[r].size())
+            heads.push(Head(readers[r][positions[r]].state(), r));
+
+        if (haveLast && head.first == last)
+            continue;
+        last = head.first;
+        haveLast = true;
+        if (previous.contains(last) || beforePrevious.contains(last))
+            continue;
+        if (!output.append(last))
+            return false;
+        layer.count++;
+    }
+    if (!output.close())
+        return false;
+
+    for (size_t r = 0; r < runs; r++)
+    {
+        readers[r].close();
+        std::remove(runPath(depth, r).c_str());
+    }
+
+    layer.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool ExternalBFS::run(int maxDepth, const std::function<void(const BfsLayer &)> &onLayer)
+{
+    mkdir(directory.c_str(), 0755);
+
+    if (loadManifest())
+    {
+        if (onLayer)
+        {
+            for (const BfsLayer &layer : completed)
+                onLayer(layer);
+        }
+    }
+    else
+    {
+        StateFileWriter writer;
+        if (!writer.create(layerPath(0), 0) || !writer.append(packState(CubieCube())) || !writer.close())
+            return false;
+        completed.push_back(BfsLayer{0, 1, 0, 0});
+        if (!saveManifest())
+            return false;
+        if (onLayer)
+            onLayer(completed.back());
+    }
+
+    for (int depth = static_cast<int>(completed.size()); depth <= maxDepth; depth++)
+    {
+        // The last layer of a finite graph is empty.
+        if (completed.back().count == 0)
+            break;
+
+        BfsLayer layer;
+        if (!buildLayer(depth, layer))
+            return false;
+        completed.push_back(layer);
+        if (!saveManifest())
+            return false;
+        if (!keepLayers && depth >= 2)
+            std::remove(layerPath(depth - 2).c_str());
+        if (onLayer)
+            onLayer(layer);
+    }
+    return true;
+}
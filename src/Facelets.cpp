@@ -0,0 +1,149 @@
+#include "Facelets.h"
+#include <cstring>
+
+// Our face index (U L F R B D) for each block of 9 characters in the string.
+static const int FACE_ORDER[6] = {0, 3, 2, 5, 1, 4};
+static const char FACE_LETTERS[6] = {'U', 'L', 'F', 'R', 'B', 'D'};
+
+const char *faceletErrorName(FaceletError error)
+{
+    switch (error)
+    {
+    case FaceletError::NONE:
+        return "ok";
+    case FaceletError::WRONG_LENGTH:
+        return "facelet string must have 54 characters";
+    case FaceletError::BAD_CENTERS:
+        return "two centers have the same color";
+    case FaceletError::UNKNOWN_COLOR:
+        return "a facelet color matches no center";
+    case FaceletError::WRONG_COLOR_COUNT:
+        return "each color must appear exactly 9 times";
+    case FaceletError::INVALID_PIECE:
+        return "a corner or edge has impossible colors";
+    case FaceletError::DUPLICATE_PIECE:
+        return "a corner or edge appears twice";
+    case FaceletError::TWISTED_CORNER:
+        return "a corner is twisted";
+    case FaceletError::FLIPPED_EDGE:
+        return "an edge is flipped";
+    case FaceletError::PARITY:
+        return "two pieces are swapped";
+    }
+    return "unknown error";
+}
+
+FaceletError validateCubie(const CubieCube &cube)
+{
+    unsigned cornersSeen = 0, edgesSeen = 0;
+    int twist = 0, flip = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        if (cube.cp[i] >= 8 || cube.co[i] >= 3)
+            return FaceletError::INVALID_PIECE;
+        cornersSeen |= 1u << cube.cp[i];
+        twist += cube.co[i];
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        if (cube.ep[i] >= 12 || cube.eo[i] >= 2)
+            return FaceletError::INVALID_PIECE;
+        edgesSeen |= 1u << cube.ep[i];
+        flip += cube.eo[i];
+    }
+
+    if (cornersSeen != 0xFF || edgesSeen != 0xFFF)
+        return FaceletError::DUPLICATE_PIECE;
+    if (twist % 3 != 0)
+        return FaceletError::TWISTED_CORNER;
+    if (flip % 2 != 0)
+        return FaceletError::FLIPPED_EDGE;
+    if (cube.cornerParity() != cube.edgeParity())
+        return FaceletError::PARITY;
+    return FaceletError::NONE;
+}
+
+FaceletError parseFacelets(const std::string &facelets, CubieCube &cube)
+{
+    if (facelets.size() != static_cast<size_t>(RubiksCube::NUM_STICKERS))
+        return FaceletError::WRONG_LENGTH;
+
+    // Map each character to the face whose center shows it.
+    int8_t faceOf[256];
+    std::memset(faceOf, -1, sizeof(faceOf));
+    for (int block = 0; block < 6; block++)
+    {
+        unsigned char center = static_cast<unsigned char>(facelets[block * 9 + 4]);
+        if (faceOf[center] >= 0)
+            return FaceletError::BAD_CENTERS;
+        faceOf[center] = static_cast<int8_t>(FACE_ORDER[block]);
+    }
+
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    int counts[6] = {0, 0, 0, 0, 0, 0};
+    for (int block = 0; block < 6; block++)
+    {
+        for (int i = 0; i < 9; i++)
+        {
+            int face = faceOf[static_cast<unsigned char>(facelets[block * 9 + i])];
+            if (face < 0)
+                return FaceletError::UNKNOWN_COLOR;
+            counts[face]++;
+            stickers[FACE_ORDER[block] * 9 + i] = static_cast<RubiksCube::Color>(face);
+        }
+    }
+    for (int face = 0; face < 6; face++)
+    {
+        if (counts[face] != 9)
+            return FaceletError::WRONG_COLOR_COUNT;
+    }
+
+    CubieCube parsed;
+    if (!parsed.fromStickers(stickers))
+        return FaceletError::INVALID_PIECE;
+    FaceletError error = validateCubie(parsed);
+    if (error == FaceletError::NONE)
+        cube = parsed;
+    return error;
+}
+
+FaceletError parseFacelets(const std::string &facelets, RubiksCube &cube)
+{
+    CubieCube parsed;
+    FaceletError error = parseFacelets(facelets, parsed);
+    if (error == FaceletError::NONE)
+        parsed.toCube(cube);
+    return error;
+}
+
+void writeFacelets(const RubiksCube::Color *stickers, char *out)
+{
+    for (int block = 0; block < 6; block++)
+    {
+        for (int i = 0; i < 9; i++)
+        {
+            out[block * 9 + i] = FACE_LETTERS[static_cast<int>(stickers[FACE_ORDER[block] * 9 + i])];
+        }
+    }
+}
+
+static std::string formatStickers(const RubiksCube::Color *stickers)
+{
+    std::string facelets(RubiksCube::NUM_STICKERS, ' ');
+    writeFacelets(stickers, &facelets[0]);
+    return facelets;
+}
+
+std::string toFacelets(const CubieCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.toStickers(stickers);
+    return formatStickers(stickers);
+}
+
+std::string toFacelets(const RubiksCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.getStickers(stickers);
+    return formatStickers(stickers);
+}
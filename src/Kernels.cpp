@@ -0,0 +1,292 @@
+#include "Kernels.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RUBIKS_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define RUBIKS_X86_KERNELS 0
+#endif
+
+// --- Generic C++ versions, used on any CPU ---
+
+static void preparePermuteGeneric(const uint8_t *source, uint8_t *control)
+{
+    std::memcpy(control, source, KERNEL_ROW_BYTES);
+}
+
+static void permuteRowsGeneric(const uint8_t *control, uint8_t *rows, size_t count)
+{
+    uint8_t before[KERNEL_ROW_BYTES];
+    for (size_t n = 0; n < count; n++)
+    {
+        uint8_t *row = rows + n * KERNEL_ROW_BYTES;
+        std::memcpy(before, row, KERNEL_ROW_BYTES);
+        for (size_t i = 0; i < KERNEL_ROW_BYTES; i++)
+        {
+            row[i] = before[control[i]];
+        }
+    }
+}
+
+static size_t countEqualRowsGeneric(const uint8_t *rows, size_t count, const uint8_t *target)
+{
+    size_t equal = 0;
+    for (size_t n = 0; n < count; n++)
+    {
+        if (std::memcmp(rows + n * KERNEL_ROW_BYTES, target, KERNEL_ROW_BYTES) == 0)
+            equal++;
+    }
+    return equal;
+}
+
+#if RUBIKS_X86_KERNELS
+
+// --- SSE2: 16-byte compares ---
+
+__attribute__((target("sse2"))) static size_t countEqualRowsSse2(const uint8_t *rows, size_t count, const uint8_t *target)
+{
+    __m128i t0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target));
+    __m128i t1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + 16));
+    __m128i t2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + 32));
+    __m128i t3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + 48));
+    size_t equal = 0;
+    for (size_t n = 0; n < count; n++)
+    {
+        const __m128i *row = reinterpret_cast<const __m128i *>(rows + n * KERNEL_ROW_BYTES);
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(row), t0), _mm_cmpeq_epi8(_mm_loadu_si128(row + 1), t1));
+        eq = _mm_and_si128(eq, _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(row + 2), t2), _mm_cmpeq_epi8(_mm_loadu_si128(row + 3), t3)));
+        equal += _mm_movemask_epi8(eq) == 0xFFFF;
+    }
+    return equal;
+}
+
+// --- SSSE3: byte shuffles within 16-byte blocks ---
+
+// Control layout: for each of the 4 output blocks, 4 shuffle masks (one per
+// input block) that pick the bytes coming from that block and zero the rest.
+__attribute__((target("ssse3"))) static void preparePermuteSsse3(const uint8_t *source, uint8_t *control)
+{
+    for (int out = 0; out < 4; out++)
+    {
+        for (int in = 0; in < 4; in++)
+        {
+            uint8_t *mask = control + (out * 4 + in) * 16;
+            for (int i = 0; i < 16; i++)
+            {
+                uint8_t src = source[out * 16 + i];
+                mask[i] = (src >> 4) == in ? static_cast<uint8_t>(src & 15) : 0x80;
+            }
+        }
+    }
+}
+
+__attribute__((target("ssse3"))) static void permuteRowsSsse3(const uint8_t *control, uint8_t *rows, size_t count)
+{
+    const __m128i *masks = reinterpret_cast<const __m128i *>(control);
+    for (size_t n = 0; n < count; n++)
+    {
+        __m128i *row = reinterpret_cast<__m128i *>(rows + n * KERNEL_ROW_BYTES);
+        __m128i in[4];
+        for (int b = 0; b < 4; b++)
+            in[b] = _mm_loadu_si128(row + b);
+        for (int out = 0; out < 4; out++)
+        {
+            __m128i result = _mm_shuffle_epi8(in[0], _mm_loadu_si128(masks + out * 4));
+            for (int b = 1; b < 4; b++)
+                result = _mm_or_si128(result, _mm_shuffle_epi8(in[b], _mm_loadu_si128(masks + out * 4 + b)));
+            _mm_storeu_si128(row + out, result);
+        }
+    }
+}
+
+// --- AVX2: the same block scheme on 32-byte halves ---
+
+// Control layout: for each of the 2 output halves, 4 masks of 32 bytes; each
+// input block is broadcast to both lanes before shuffling.
+__attribute__((target("avx2"))) static void preparePermuteAvx2(const uint8_t *source, uint8_t *control)
+{
+    for (int half = 0; half < 2; half++)
+    {
+        for (int in = 0; in < 4; in++)
+        {
+            uint8_t *mask = control + (half * 4 + in) * 32;
+            for (int i = 0; i < 32; i++)
+            {
+                uint8_t src = source[half * 32 + i];
+                mask[i] = (src >> 4) == in ? static_cast<uint8_t>(src & 15) : 0x80;
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2"))) static void permuteRowsAvx2(const uint8_t *control, uint8_t *rows, size_t count)
+{
+    __m256i masks[8];
+    for (int i = 0; i < 8; i++)
+        masks[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(control) + i);
+
+    for (size_t n = 0; n < count; n++)
+    {
+        uint8_t *row = rows + n * KERNEL_ROW_BYTES;
+        __m256i in[4];
+        for (int b = 0; b < 4; b++)
+            in[b] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row) + b));
+
+        __m256i lo = _mm256_shuffle_epi8(in[0], masks[0]);
+        __m256i hi = _mm256_shuffle_epi8(in[0], masks[4]);
+        for (int b = 1; b < 4; b++)
+        {
+            lo = _mm256_or_si256(lo, _mm256_shuffle_epi8(in[b], masks[b]));
+            hi = _mm256_or_si256(hi, _mm256_shuffle_epi8(in[b], masks[4 + b]));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(row), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(row) + 1, hi);
+    }
+}
+
+__attribute__((target("avx2"))) static void permuteSequenceAvx2(const uint8_t *controls, const Move *moves, size_t length,
+                                                                 uint8_t *row)
+{
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row) + 1);
+    for (size_t k = 0; k < length; k++)
+    {
+        const __m256i *masks = reinterpret_cast<const __m256i *>(controls + static_cast<size_t>(moves[k]) * KERNEL_CONTROL_BYTES);
+        // Each input block in both lanes.
+        __m256i in[4] = {_mm256_permute2x128_si256(lo, lo, 0x00), _mm256_permute2x128_si256(lo, lo, 0x11),
+                         _mm256_permute2x128_si256(hi, hi, 0x00), _mm256_permute2x128_si256(hi, hi, 0x11)};
+        __m256i nextLo = _mm256_shuffle_epi8(in[0], _mm256_loadu_si256(masks));
+        __m256i nextHi = _mm256_shuffle_epi8(in[0], _mm256_loadu_si256(masks + 4));
+        for (int b = 1; b < 4; b++)
+        {
+            nextLo = _mm256_or_si256(nextLo, _mm256_shuffle_epi8(in[b], _mm256_loadu_si256(masks + b)));
+            nextHi = _mm256_or_si256(nextHi, _mm256_shuffle_epi8(in[b], _mm256_loadu_si256(masks + 4 + b)));
+        }
+        lo = nextLo;
+        hi = nextHi;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(row), lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(row) + 1, hi);
+}
+
+__attribute__((target("avx2"))) static size_t countEqualRowsAvx2(const uint8_t *rows, size_t count, const uint8_t *target)
+{
+    __m256i t0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target));
+    __m256i t1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target) + 1);
+    size_t equal = 0;
+    for (size_t n = 0; n < count; n++)
+    {
+        const __m256i *row = reinterpret_cast<const __m256i *>(rows + n * KERNEL_ROW_BYTES);
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(row), t0), _mm256_cmpeq_epi8(_mm256_loadu_si256(row + 1), t1));
+        equal += _mm256_movemask_epi8(eq) == -1;
+    }
+    return equal;
+}
+
+// --- AVX-512: one full-row byte permute (VBMI) and one masked compare (BW) ---
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) static void permuteRowsAvx512(const uint8_t *control, uint8_t *rows, size_t count)
+{
+    __m512i index = _mm512_loadu_si512(control);
+    for (size_t n = 0; n < count; n++)
+    {
+        uint8_t *row = rows + n * KERNEL_ROW_BYTES;
+        _mm512_storeu_si512(row, _mm512_maskz_permutexvar_epi8(~0ULL, index, _mm512_loadu_si512(row)));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) static void permuteSequenceAvx512(const uint8_t *controls, const Move *moves,
+                                                                                      size_t length, uint8_t *row)
+{
+    __m512i state = _mm512_loadu_si512(row);
+    for (size_t k = 0; k < length; k++)
+        state = _mm512_maskz_permutexvar_epi8(~0ULL, _mm512_loadu_si512(controls + static_cast<size_t>(moves[k]) * KERNEL_CONTROL_BYTES), state);
+    _mm512_storeu_si512(row, state);
+}
+
+__attribute__((target("avx512f,avx512bw"))) static size_t countEqualRowsAvx512(const uint8_t *rows, size_t count, const uint8_t *target)
+{
+    __m512i t = _mm512_loadu_si512(target);
+    size_t equal = 0;
+    for (size_t n = 0; n < count; n++)
+    {
+        equal += _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(rows + n * KERNEL_ROW_BYTES), t) == 0;
+    }
+    return equal;
+}
+
+static const KernelTable VARIANTS[] = {
+    {"avx512", preparePermuteGeneric, permuteRowsAvx512, permuteSequenceAvx512, countEqualRowsAvx512},
+    {"avx2", preparePermuteAvx2, permuteRowsAvx2, permuteSequenceAvx2, countEqualRowsAvx2},
+    {"ssse3", preparePermuteSsse3, permuteRowsSsse3, nullptr, countEqualRowsSse2},
+    {"sse2", preparePermuteGeneric, permuteRowsGeneric, nullptr, countEqualRowsSse2},
+    {"generic", preparePermuteGeneric, permuteRowsGeneric, nullptr, countEqualRowsGeneric}};
+
+bool kernelSupported(size_t index)
+{
+    __builtin_cpu_init();
+    switch (index)
+    {
+    case 0:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+    case 1:
+        return __builtin_cpu_supports("avx2");
+    case 2:
+        return __builtin_cpu_supports("ssse3");
+    case 3:
+        return __builtin_cpu_supports("sse2");
+    default:
+        return true;
+    }
+}
+
+#else
+
+static const KernelTable VARIANTS[] = {
+    {"generic", preparePermuteGeneric, permuteRowsGeneric, nullptr, countEqualRowsGeneric}};
+
+bool kernelSupported(size_t)
+{
+    return true;
+}
+
+#endif // RUBIKS_X86_KERNELS
+
+size_t availableKernelCount()
+{
+    return sizeof(VARIANTS) / sizeof(VARIANTS[0]);
+}
+
+const KernelTable &kernelVariant(size_t index)
+{
+    return VARIANTS[index];
+}
+
+// Picks the best supported variant, or the one named by RUBIKS_KERNEL if the
+// CPU supports it.
+static const KernelTable &selectKernels()
+{
+    const char *forced = std::getenv("RUBIKS_KERNEL");
+    if (forced != nullptr)
+    {
+        for (size_t i = 0; i < availableKernelCount(); i++)
+        {
+            if (std::strcmp(VARIANTS[i].name, forced) == 0 && kernelSupported(i))
+                return VARIANTS[i];
+        }
+    }
+    for (size_t i = 0; i < availableKernelCount(); i++)
+    {
+        if (kernelSupported(i))
+            return VARIANTS[i];
+    }
+    return VARIANTS[availableKernelCount() - 1];
+}
+
+const KernelTable &activeKernels()
+{
+    static const KernelTable &selected = selectKernels();
+    return selected;
+}
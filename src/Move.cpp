@@ -0,0 +1,152 @@
+#include "Move.h"
+
+const char *moveName(Move move)
+{
+    static const char *names[NUM_MOVES] = {
+        "U", "U'", "U2",
+        "L", "L'", "L2",
+        "F", "F'", "F2",
+        "R", "R'", "R2",
+        "B", "B'", "B2",
+        "D", "D'", "D2"};
+    return names[static_cast<int>(move)];
+}
+
+// Maps a face letter to its face index, or -1.
+static int faceFromChar(char c)
+{
+    switch (c)
+    {
+    case 'U':
+        return 0;
+    case 'L':
+        return 1;
+    case 'F':
+        return 2;
+    case 'R':
+        return 3;
+    case 'B':
+        return 4;
+    case 'D':
+        return 5;
+    }
+    return -1;
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',';
+}
+
+int parseMoves(const char *text, Move *out, size_t capacity)
+{
+    size_t count = 0;
+    const char *p = text;
+    while (true)
+    {
+        while (isSpace(*p))
+            p++;
+        if (*p == '\0')
+            break;
+
+        int face = faceFromChar(*p++);
+        if (face < 0 || count == capacity)
+            return -1;
+
+        int quarterTurns = 1;
+        if (*p == '2')
+        {
+            quarterTurns = 2;
+            p++;
+            // "2'" is the same half turn.
+            if (*p == '\'')
+                p++;
+        }
+        else if (*p == '\'')
+        {
+            quarterTurns = 3;
+            p++;
+        }
+        out[count++] = makeMove(face, quarterTurns);
+    }
+    return static_cast<int>(count);
+}
+
+size_t simplifyMoves(Move *moves, size_t count)
+{
+    // The output is built in place as a stack; `n` never overtakes the read index.
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        Move move = moves[i];
+        int face = moveFace(move);
+
+        // Find an earlier turn of the same face that this one can merge with:
+        // either the previous move, or the one before it when the previous
+        // move turns the opposite face.
+        size_t target = n;
+        if (n >= 1 && moveFace(moves[n - 1]) == face)
+        {
+            target = n - 1;
+        }
+        else if (n >= 2 && moveFace(moves[n - 1]) == oppositeFace(face) && moveFace(moves[n - 2]) == face)
+        {
+            target = n - 2;
+        }
+
+        if (target == n)
+        {
+            moves[n++] = move;
+            // Keep commuting pairs in canonical order.
+            if (n >= 2 && moveFace(moves[n - 2]) == oppositeFace(face) && moveFace(moves[n - 2]) > face)
+            {
+                Move tmp = moves[n - 2];
+                moves[n - 2] = moves[n - 1];
+                moves[n - 1] = tmp;
+            }
+            continue;
+        }
+
+        int quarterTurns = (moveQuarterTurns(moves[target]) + moveQuarterTurns(move)) & 3;
+        if (quarterTurns != 0)
+        {
+            moves[target] = makeMove(face, quarterTurns);
+            continue;
+        }
+
+        // The turns cancel: remove the earlier one.
+        if (target == n - 2)
+        {
+            moves[n - 2] = moves[n - 1];
+        }
+        n--;
+    }
+    return n;
+}
+
+bool parseAlgorithm(const std::string &text, std::vector<Move> &moves)
+{
+    // Every move takes at least one character, so this is always large enough.
+    moves.resize(text.size());
+    int count = parseMoves(text.c_str(), moves.data(), moves.size());
+    if (count < 0)
+    {
+        moves.clear();
+        return false;
+    }
+    moves.resize(simplifyMoves(moves.data(), static_cast<size_t>(count)));
+    return true;
+}
+
+std::string formatMoves(const Move *moves, size_t count)
+{
+    std::string result;
+    result.reserve(count * 3);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+            result += ' ';
+        result += moveName(moves[i]);
+    }
+    return result;
+}
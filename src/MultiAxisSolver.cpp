@@ -0,0 +1,117 @@
+#include "MultiAxisSolver.h"
+#include "Facelets.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Rotations taking the U-D axis to itself, to R-L and to F-B.
+struct AxisRotations
+{
+    int symmetry[3];
+
+    AxisRotations()
+    {
+        static const int targetFace[3] = {0, 3, 2};
+        for (int axis = 0; axis < 3; axis++)
+        {
+            // A clockwise image of U rules out the mirrors.
+            int s = 0;
+            while (symmetryMove(s, Move::U) != makeMove(targetFace[axis], 1))
+                s++;
+            symmetry[axis] = s;
+        }
+    }
+};
+
+static const AxisRotations &axisRotations()
+{
+    static const AxisRotations rotations;
+    return rotations;
+}
+
+// Maps a solution of a variant back to the original cube. A solution of the
+// inverse cube, reversed and inverted, solves the cube.
+static std::vector<Move> mapBack(const std::vector<Move> &solution, int symmetry, bool inverted)
+{
+    int back = inverseSymmetry(symmetry);
+    std::vector<Move> mapped(solution.size());
+    for (size_t i = 0; i < solution.size(); i++)
+    {
+        Move m = symmetryMove(back, solution[i]);
+        if (inverted)
+            mapped[solution.size() - 1 - i] = inverse(m);
+        else
+            mapped[i] = m;
+    }
+    return mapped;
+}
+
+MultiAxisSolver::MultiAxisSolver(int variants) : variants(std::max(1, std::min(variants, static_cast<int>(MAX_VARIANTS))))
+{
+}
+
+TwoPhaseResult MultiAxisSolver::solve(const CubieCube &cube, const TwoPhaseOptions &options) const
+{
+    if (validateCubie(cube) != FaceletError::NONE)
+        return TwoPhaseResult{SearchOutcome::INVALID_CUBE, false, {}, 0};
+
+    std::atomic<int> sharedBest(std::min(options.maxLength, static_cast<int>(TwoPhaseSolver::MAX_LENGTH)) + 1);
+    std::mutex mutex;
+    size_t reportedLength = SIZE_MAX;
+    std::vector<TwoPhaseResult> results(variants);
+
+    auto run = [&](int variant) {
+        int symmetry = axisRotations().symmetry[variant / 2];
+        bool inverted = variant % 2 == 1;
+        CubieCube view = applySymmetry(symmetry, inverted ? cube.inverse() : cube);
+
+        TwoPhaseOptions variantOptions = options;
+        variantOptions.sharedBest = &sharedBest;
+        variantOptions.onSolution = [&](const std::vector<Move> &solution) {
+            // Two searches can each beat the bound they last saw; only pass
+            // on real improvements.
+            std::lock_guard<std::mutex> lock(mutex);
+            if (solution.size() >= reportedLength)
+                return;
+            reportedLength = solution.size();
+            if (options.onSolution)
+                options.onSolution(mapBack(solution, symmetry, inverted));
+        };
+
+        TwoPhaseSolver solver;
+        results[variant] = solver.solve(view, variantOptions);
+        results[variant].solution = mapBack(results[variant].solution, symmetry, inverted);
+    };
+
+    if (variants == 1)
+    {
+        run(0);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (int v = 0; v < variants; v++)
+            threads.emplace_back(run, v);
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    // The shortest solution wins. Otherwise a target reached anywhere beats
+    // an interrupted search, which beats one that ran out of depths.
+    TwoPhaseResult combined{SearchOutcome::EXHAUSTED, false, {}, 0};
+    for (const TwoPhaseResult &result : results)
+    {
+        combined.nodes += result.nodes;
+        if (result.found && (!combined.found || result.solution.size() < combined.solution.size()))
+        {
+            combined.found = true;
+            combined.solution = result.solution;
+        }
+        if (result.outcome == SearchOutcome::TARGET_REACHED ||
+            (result.outcome != SearchOutcome::EXHAUSTED && combined.outcome == SearchOutcome::EXHAUSTED))
+            combined.outcome = result.outcome;
+    }
+    return combined;
+}
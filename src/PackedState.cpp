@@ -0,0 +1,58 @@
+#include "PackedState.h"
+
+PackedState packState(const CubieCube &cube)
+{
+    PackedState state;
+    uint64_t lo = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        lo |= static_cast<uint64_t>(cube.cp[i]) << (3 * i);
+        lo |= static_cast<uint64_t>(cube.co[i]) << (24 + 2 * i);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        lo |= static_cast<uint64_t>(cube.eo[i]) << (40 + i);
+    }
+
+    uint64_t hi = 0;
+    for (int i = 0; i < 12; i++)
+    {
+        hi |= static_cast<uint64_t>(cube.ep[i]) << (4 * i);
+    }
+
+    state.lo = lo;
+    state.hi = hi;
+    return state;
+}
+
+CubieCube unpackState(const PackedState &state)
+{
+    CubieCube cube;
+    for (int i = 0; i < 8; i++)
+    {
+        cube.cp[i] = static_cast<uint8_t>((state.lo >> (3 * i)) & 7);
+        cube.co[i] = static_cast<uint8_t>((state.lo >> (24 + 2 * i)) & 3);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        cube.eo[i] = static_cast<uint8_t>((state.lo >> (40 + i)) & 1);
+        cube.ep[i] = static_cast<uint8_t>((state.hi >> (4 * i)) & 15);
+    }
+    return cube;
+}
+
+bool packCube(const RubiksCube &cube, PackedState &state)
+{
+    CubieCube cubie;
+    if (!cubie.fromCube(cube))
+    {
+        return false;
+    }
+    state = packState(cubie);
+    return true;
+}
+
+void unpackCube(const PackedState &state, RubiksCube &cube)
+{
+    unpackState(state).toCube(cube);
+}
@@ -0,0 +1,509 @@
+#include "PatternDatabase.h"
+#include "Coordinates.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+static const char PATTERN_DATABASE_MAGIC[8] = {'R', 'U', 'B', 'I', 'K', 'P', 'D', 'B'};
+static const char *const PATTERN_KIND_NAMES[NUM_PATTERN_KINDS] = {"corners", "edges-first", "edges-last"};
+static const char *const ENCODING_NAMES[] = {"nibbles", "mod3"};
+static constexpr uint32_t NUM_ENCODINGS = 2;
+
+static constexpr int TRACKED_EDGES = 6;
+// Placements of 6 distinct edges in 12 slots: 12 * 11 * 10 * 9 * 8 * 7.
+static constexpr int NUM_EDGE_PLACEMENTS = 665280;
+static constexpr int NUM_EDGE_FLIPS = 1 << TRACKED_EDGES;
+static constexpr int UNSEEN = 0xF;
+
+const char *patternKindName(PatternKind kind)
+{
+    return PATTERN_KIND_NAMES[static_cast<int>(kind)];
+}
+
+bool parsePatternKind(const std::string &name, PatternKind &kind)
+{
+    for (int k = 0; k < NUM_PATTERN_KINDS; k++)
+    {
+        if (name == PATTERN_KIND_NAMES[k])
+        {
+            kind = static_cast<PatternKind>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *pdbEncodingName(uint32_t encoding)
+{
+    return encoding < NUM_ENCODINGS ? ENCODING_NAMES[encoding] : "unknown";
+}
+
+bool parsePdbEncoding(const std::string &name, uint32_t &encoding)
+{
+    for (uint32_t e = 0; e < NUM_ENCODINGS; e++)
+    {
+        if (name == ENCODING_NAMES[e])
+        {
+            encoding = e;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Bytes holding `count` entries in the given encoding.
+static uint64_t entryBytes(uint32_t encoding, uint64_t count)
+{
+    return encoding == PDB_ENCODING_MOD3 ? (count + 3) / 4 : (count + 1) / 2;
+}
+
+uint64_t PatternDatabase::entryCount(PatternKind kind)
+{
+    if (kind == PatternKind::CORNERS)
+        return uint64_t(NUM_CORNER_PERM) * NUM_TWIST;
+    return uint64_t(NUM_EDGE_PLACEMENTS) * NUM_EDGE_FLIPS;
+}
+
+// Rank of the slots holding six tracked edges, each digit counting the free
+// slots below that edge's slot.
+static int edgePlacementRank(const uint8_t *slots)
+{
+    int rank = 0;
+    unsigned used = 0;
+    for (int k = 0; k < TRACKED_EDGES; k++)
+    {
+        int below = __builtin_popcount(used & ((1u << slots[k]) - 1));
+        rank = rank * (12 - k) + slots[k] - below;
+        used |= 1u << slots[k];
+    }
+    return rank;
+}
+
+static void edgePlacementUnrank(int rank, uint8_t *slots)
+{
+    int digits[TRACKED_EDGES];
+    for (int k = TRACKED_EDGES - 1; k >= 0; k--)
+    {
+        digits[k] = rank % (12 - k);
+        rank /= 12 - k;
+    }
+    unsigned used = 0;
+    for (int k = 0; k < TRACKED_EDGES; k++)
+    {
+        // The digits[k]-th free slot.
+        int slot = 0;
+        for (int free = digits[k];; slot++)
+        {
+            if (used & (1u << slot))
+                continue;
+            if (free-- == 0)
+                break;
+        }
+        slots[k] = static_cast<uint8_t>(slot);
+        used |= 1u << slot;
+    }
+}
+
+uint64_t PatternDatabase::index(PatternKind kind, const CubieCube &cube)
+{
+    if (kind == PatternKind::CORNERS)
+        return uint64_t(cornerPermCoord(cube)) * NUM_TWIST + twistCoord(cube);
+
+    int first = kind == PatternKind::EDGES_FIRST ? 0 : TRACKED_EDGES;
+    uint8_t slots[TRACKED_EDGES];
+    int flips = 0;
+    for (int slot = 0; slot < 12; slot++)
+    {
+        int k = cube.ep[slot] - first;
+        if (k < 0 || k >= TRACKED_EDGES)
+            continue;
+        slots[k] = static_cast<uint8_t>(slot);
+        flips |= cube.eo[slot] << k;
+    }
+    return uint64_t(edgePlacementRank(slots)) * NUM_EDGE_FLIPS + flips;
+}
+
+static void setEntry(uint8_t *entries, uint64_t i, int value)
+{
+    uint8_t &byte = entries[i >> 1];
+    int shift = (i & 1) << 2;
+    byte = static_cast<uint8_t>((byte & ~(0xF << shift)) | (value << shift));
+}
+
+static int getEntry(const uint8_t *entries, uint64_t i)
+{
+    return (entries[i >> 1] >> ((i & 1) << 2)) & 0xF;
+}
+
+// Where a build stands: the level being built (entries at `depth` are being
+// expanded into depth + 1) and how far its scan has got.
+struct BuildProgress
+{
+    static constexpr int MAX_LEVELS = 16;
+
+    int depth;
+    uint64_t position;
+    uint64_t seen;  // entries known when the level started
+    uint64_t found; // entries the level has found so far
+    uint64_t levelCounts[MAX_LEVELS];
+};
+
+static const char CHECKPOINT_MAGIC[8] = {'R', 'U', 'B', 'I', 'K', 'C', 'K', 'P'};
+static constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+// Checkpoint file: this header, then the table entries as in a table file.
+struct CheckpointHeader
+{
+    char magic[8]; // "RUBIKCKP"
+    uint32_t version;
+    uint32_t kind;
+    uint64_t entryCount;
+    BuildProgress progress;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Writes to a temporary file, syncs it and renames it over the old
+// checkpoint.
+static bool writeCheckpoint(const std::string &path, PatternKind kind, uint64_t count, const BuildProgress &progress,
+                            const uint8_t *entries)
+{
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.kind = static_cast<uint32_t>(kind);
+    header.entryCount = count;
+    header.progress = progress;
+
+    std::string temporary = path + ".tmp";
+    std::FILE *out = std::fopen(temporary.c_str(), "wb");
+    if (!out)
+        return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(entries, 1, (count + 1) / 2, out) == (count + 1) / 2 && std::fflush(out) == 0 &&
+              fsync(fileno(out)) == 0;
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Reads a checkpoint of this table. False if there is none or it belongs to
+// a different table; `entries` may then have been overwritten.
+static bool readCheckpoint(const std::string &path, PatternKind kind, uint64_t count, BuildProgress &progress,
+                           uint8_t *entries)
+{
+    std::FILE *in = std::fopen(path.c_str(), "rb");
+    if (!in)
+        return false;
+    CheckpointHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, in) == 1 &&
+              std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == CHECKPOINT_VERSION && header.kind == static_cast<uint32_t>(kind) &&
+              header.entryCount == count && header.progress.depth >= 0 &&
+              header.progress.depth < BuildProgress::MAX_LEVELS - 1 && header.progress.position <= count &&
+              std::fread(entries, 1, (count + 1) / 2, in) == (count + 1) / 2;
+    std::fclose(in);
+    if (ok)
+        progress = header.progress;
+    return ok;
+}
+
+// Breadth-first search by levels. While few entries are known, each level
+// expands the entries at the current depth; once most are known it is
+// cheaper to scan the unknown ones for a neighbor at that depth (moves come
+// in inverse pairs, so both find the same entries).
+//
+// Everything a level needs is in the table, so a checkpoint is the table
+// plus the scan position, taken between chunks of the scan.
+template <typename Next>
+static int breadthFirst(uint8_t *entries, PatternKind kind, uint64_t count, uint64_t goal, Next next,
+                        const PatternBuildOptions &options)
+{
+    static constexpr uint64_t CHUNK = 1 << 20;
+    bool checkpoints = !options.checkpointPath.empty();
+
+    BuildProgress progress;
+    std::memset(&progress, 0, sizeof(progress));
+    auto readStart = std::chrono::steady_clock::now();
+    if (checkpoints && readCheckpoint(options.checkpointPath, kind, count, progress, entries))
+    {
+        if (options.onCheckpoint)
+            options.onCheckpoint({true, true, progress.depth + 1, progress.position, sizeof(CheckpointHeader) + (count + 1) / 2,
+                                  secondsSince(readStart)});
+    }
+    else
+    {
+        std::memset(&progress, 0, sizeof(progress));
+        std::memset(entries, 0xFF, (count + 1) / 2);
+        setEntry(entries, goal, 0);
+        progress.seen = 1;
+        progress.levelCounts[0] = 1;
+    }
+    if (options.onLevel)
+    {
+        for (int d = 0; d <= progress.depth; d++)
+            options.onLevel(d, progress.levelCounts[d]);
+    }
+
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+    for (;; progress.depth++)
+    {
+        int depth = progress.depth;
+        bool forward = progress.seen < count / 2;
+        while (progress.position < count)
+        {
+            uint64_t end = std::min(progress.position + CHUNK, count);
+            for (uint64_t i = progress.position; i < end; i++)
+            {
+                if (forward)
+                {
+                    if (getEntry(entries, i) != depth)
+                        continue;
+                    for (int m = 0; m < NUM_MOVES; m++)
+                    {
+                        uint64_t j = next(i, m);
+                        if (getEntry(entries, j) == UNSEEN)
+                        {
+                            setEntry(entries, j, depth + 1);
+                            progress.found++;
+                        }
+                    }
+                }
+                else
+                {
+                    if (getEntry(entries, i) != UNSEEN)
+                        continue;
+                    for (int m = 0; m < NUM_MOVES; m++)
+                    {
+                        if (getEntry(entries, next(i, m)) == depth)
+                        {
+                            setEntry(entries, i, depth + 1);
+                            progress.found++;
+                            break;
+                        }
+                    }
+                }
+            }
+            progress.position = end;
+
+            if (checkpoints && secondsSince(lastCheckpoint) >= options.checkpointSeconds)
+            {
+                auto writeStart = std::chrono::steady_clock::now();
+                bool ok = writeCheckpoint(options.checkpointPath, kind, count, progress, entries);
+                if (options.onCheckpoint)
+                    options.onCheckpoint({false, ok, depth + 1, progress.position, sizeof(CheckpointHeader) + (count + 1) / 2,
+                                          secondsSince(writeStart)});
+                lastCheckpoint = std::chrono::steady_clock::now();
+            }
+        }
+
+        if (progress.found == 0 || depth + 1 >= BuildProgress::MAX_LEVELS - 1)
+            break;
+        progress.seen += progress.found;
+        progress.levelCounts[depth + 1] = progress.found;
+        if (options.onLevel)
+            options.onLevel(depth + 1, progress.found);
+        progress.found = 0;
+        progress.position = 0;
+    }
+    if (checkpoints)
+        std::remove(options.checkpointPath.c_str());
+    return progress.depth;
+}
+
+bool PatternDatabase::build(PatternKind kind, const PatternBuildOptions &options)
+{
+    entries = nullptr;
+    mod3 = false;
+    uint64_t count = entryCount(kind);
+    if (!image.allocate(sizeof(PatternDatabaseHeader) + (count + 1) / 2, options.policy))
+        return false;
+    uint8_t *table = image.data() + sizeof(PatternDatabaseHeader);
+    uint64_t goal = index(kind, CubieCube());
+
+    int maxDepth;
+    if (kind == PatternKind::CORNERS)
+    {
+        // Coordinate move tables: coordinate * NUM_MOVES + move.
+        std::vector<uint16_t> permMove(NUM_CORNER_PERM * NUM_MOVES), twistMove(NUM_TWIST * NUM_MOVES);
+        for (int coord = 0; coord < NUM_CORNER_PERM; coord++)
+        {
+            CubieCube cube;
+            setCornerPermCoord(cube, coord);
+            for (int m = 0; m < NUM_MOVES; m++)
+            {
+                CubieCube child = cube;
+                child.move(static_cast<Move>(m));
+                permMove[coord * NUM_MOVES + m] = static_cast<uint16_t>(cornerPermCoord(child));
+            }
+        }
+        for (int coord = 0; coord < NUM_TWIST; coord++)
+        {
+            CubieCube cube;
+            setTwistCoord(cube, coord);
+            for (int m = 0; m < NUM_MOVES; m++)
+            {
+                CubieCube child = cube;
+                child.move(static_cast<Move>(m));
+                twistMove[coord * NUM_MOVES + m] = static_cast<uint16_t>(twistCoord(child));
+            }
+        }
+        maxDepth = breadthFirst(table, kind, count, goal, [&](uint64_t i, int m) {
+            return uint64_t(permMove[i / NUM_TWIST * NUM_MOVES + m]) * NUM_TWIST + twistMove[i % NUM_TWIST * NUM_MOVES + m];
+        }, options);
+    }
+    else
+    {
+        // Where a move takes the edge in each slot, and whether it flips it.
+        uint8_t target[NUM_MOVES][12], flipped[NUM_MOVES][12];
+        for (int m = 0; m < NUM_MOVES; m++)
+        {
+            const CubieCube &move = CubieCube::moveCube(static_cast<Move>(m));
+            for (int slot = 0; slot < 12; slot++)
+            {
+                target[m][move.ep[slot]] = static_cast<uint8_t>(slot);
+                flipped[m][move.ep[slot]] = move.eo[slot];
+            }
+        }
+        // The placement part moves on its own; the flips change by a mask
+        // that depends only on the placement.
+        std::vector<uint32_t> placementMove(size_t(NUM_EDGE_PLACEMENTS) * NUM_MOVES);
+        std::vector<uint8_t> flipMask(size_t(NUM_EDGE_PLACEMENTS) * NUM_MOVES);
+        for (int rank = 0; rank < NUM_EDGE_PLACEMENTS; rank++)
+        {
+            uint8_t slots[TRACKED_EDGES], moved[TRACKED_EDGES];
+            edgePlacementUnrank(rank, slots);
+            for (int m = 0; m < NUM_MOVES; m++)
+            {
+                int mask = 0;
+                for (int k = 0; k < TRACKED_EDGES; k++)
+                {
+                    moved[k] = target[m][slots[k]];
+                    mask |= flipped[m][slots[k]] << k;
+                }
+                placementMove[size_t(rank) * NUM_MOVES + m] = static_cast<uint32_t>(edgePlacementRank(moved));
+                flipMask[size_t(rank) * NUM_MOVES + m] = static_cast<uint8_t>(mask);
+            }
+        }
+        maxDepth = breadthFirst(table, kind, count, goal, [&](uint64_t i, int m) {
+            size_t at = size_t(i / NUM_EDGE_FLIPS) * NUM_MOVES + m;
+            return uint64_t(placementMove[at]) * NUM_EDGE_FLIPS + ((i % NUM_EDGE_FLIPS) ^ flipMask[at]);
+        }, options);
+    }
+
+    PatternDatabaseHeader *h = reinterpret_cast<PatternDatabaseHeader *>(image.data());
+    std::memcpy(h->magic, PATTERN_DATABASE_MAGIC, sizeof(h->magic));
+    h->version = PATTERN_DATABASE_VERSION;
+    h->kind = static_cast<uint32_t>(kind);
+    h->encoding = PDB_ENCODING_NIBBLES;
+    h->maxDistance = static_cast<uint32_t>(maxDepth);
+    h->entryCount = count;
+    entries = table;
+    return options.encoding != PDB_ENCODING_MOD3 || encodeMod3(options.policy);
+}
+
+bool PatternDatabase::encodeMod3(PagePolicy policy)
+{
+    if (!isLoaded() || mod3)
+        return isLoaded();
+    uint64_t count = header().entryCount;
+    TableMemory packed;
+    if (!packed.allocate(sizeof(PatternDatabaseHeader) + entryBytes(PDB_ENCODING_MOD3, count), policy))
+        return false;
+    std::memcpy(packed.data(), image.data(), sizeof(PatternDatabaseHeader));
+    reinterpret_cast<PatternDatabaseHeader *>(packed.data())->encoding = PDB_ENCODING_MOD3;
+
+    uint8_t *table = packed.data() + sizeof(PatternDatabaseHeader);
+    std::memset(table, 0, entryBytes(PDB_ENCODING_MOD3, count));
+    for (uint64_t i = 0; i < count; i++)
+        table[i >> 2] |= static_cast<uint8_t>(getEntry(entries, i) % 3 << ((i & 3) << 1));
+
+    image = std::move(packed);
+    entries = table;
+    mod3 = true;
+    return true;
+}
+
+// Follows moves that each lead one closer, to the entry whose residue is one
+// below, until the goal (the only entry at distance 0) is reached.
+int PatternDatabase::walkToGoal(const CubieCube &cube) const
+{
+    PatternKind k = kind();
+    uint64_t goal = index(k, CubieCube());
+    CubieCube work = cube;
+    uint64_t i = index(k, work);
+    int distance = 0;
+    for (; i != goal && distance < maxDistance(); distance++)
+    {
+        int closer = (entry(i) + 2) % 3;
+        for (int m = 0; m < NUM_MOVES; m++)
+        {
+            CubieCube child = work;
+            child.move(static_cast<Move>(m));
+            uint64_t j = index(k, child);
+            if (entry(j) == closer)
+            {
+                work = child;
+                i = j;
+                break;
+            }
+        }
+    }
+    return distance;
+}
+
+bool PatternDatabase::save(const std::string &path) const
+{
+    if (!isLoaded())
+        return false;
+    std::FILE *out = std::fopen(path.c_str(), "wb");
+    if (!out)
+        return false;
+    bool ok = std::fwrite(image.data(), 1, image.size(), out) == image.size();
+    ok = std::fclose(out) == 0 && ok;
+    return ok;
+}
+
+bool PatternDatabase::validate()
+{
+    entries = nullptr;
+    mod3 = false;
+    if (image.size() < sizeof(PatternDatabaseHeader))
+        return false;
+    const PatternDatabaseHeader &h = header();
+    bool ok = std::memcmp(h.magic, PATTERN_DATABASE_MAGIC, sizeof(h.magic)) == 0 && h.version == PATTERN_DATABASE_VERSION &&
+              h.kind < NUM_PATTERN_KINDS && h.encoding < NUM_ENCODINGS && h.maxDistance < UNSEEN &&
+              h.entryCount == entryCount(static_cast<PatternKind>(h.kind)) &&
+              image.size() == sizeof(PatternDatabaseHeader) + entryBytes(h.encoding, h.entryCount);
+    if (!ok)
+    {
+        image.release();
+        return false;
+    }
+    entries = image.data() + sizeof(PatternDatabaseHeader);
+    mod3 = h.encoding == PDB_ENCODING_MOD3;
+    return true;
+}
+
+bool PatternDatabase::load(const std::string &path, PagePolicy policy)
+{
+    entries = nullptr;
+    return image.loadFile(path, policy) && validate();
+}
+
+bool PatternDatabase::map(const std::string &path, PagePolicy policy)
+{
+    entries = nullptr;
+    return image.mapFile(path, policy) && validate();
+}
@@ -0,0 +1,172 @@
+#include "PeepholeOptimizer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+static const uint64_t KEY_MASK = (1ULL << 52) - 1;
+static const int DEPTH_SHIFT = 52;
+static const int MOVE_SHIFT = 56;
+static const int NO_MOVE = 31;
+
+PeepholeOptimizer::PeepholeOptimizer(int depth, int maxWindow)
+    : tableDepth(depth < 0 ? 0 : depth > MAX_DEPTH ? MAX_DEPTH : depth),
+      window(maxWindow > 0 ? maxWindow : 2 * tableDepth)
+{
+    RUBIKS_PROFILE_SCOPE("Peephole::build");
+    slots.assign(1 << 10, Slot{0, 0});
+    mask = slots.size() - 1;
+
+    std::vector<PackedState> frontier;
+    std::vector<PackedState> next;
+    PackedState solved = packState(CubieCube());
+    insert(solved, 0, NO_MOVE);
+    frontier.push_back(solved);
+
+    for (int d = 1; d <= tableDepth; d++)
+    {
+        next.clear();
+        for (const PackedState &state : frontier)
+        {
+            CubieCube cube = unpackState(state);
+            int lastMove = static_cast<int>(find(state)->lo >> MOVE_SHIFT & 31);
+            int lastFace = lastMove == NO_MOVE ? -1 : lastMove / 3;
+            for (int m = 0; m < NUM_MOVES; m++)
+            {
+                // Same-face turns only lead back to shallower positions.
+                if (m / 3 == lastFace)
+                    continue;
+                CubieCube child = cube;
+                child.move(static_cast<Move>(m));
+                PackedState packed = packState(child);
+                if (insert(packed, d, m))
+                    next.push_back(packed);
+            }
+        }
+        frontier.swap(next);
+    }
+}
+
+const PeepholeOptimizer::Slot *PeepholeOptimizer::find(const PackedState &state) const
+{
+    size_t i = PackedStateHash()(state) & mask;
+    while (slots[i].lo != 0)
+    {
+        if ((slots[i].lo & KEY_MASK) == state.lo && slots[i].hi == state.hi)
+            return &slots[i];
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+// Adds a state unless it is already present. Returns whether it was added.
+bool PeepholeOptimizer::insert(const PackedState &state, int depth, int lastMove)
+{
+    if ((count + 1) * 4 > slots.size() * 3)
+        grow();
+
+    size_t i = PackedStateHash()(state) & mask;
+    while (slots[i].lo != 0)
+    {
+        if ((slots[i].lo & KEY_MASK) == state.lo && slots[i].hi == state.hi)
+            return false;
+        i = (i + 1) & mask;
+    }
+    slots[i].lo = state.lo | static_cast<uint64_t>(depth) << DEPTH_SHIFT | static_cast<uint64_t>(lastMove) << MOVE_SHIFT;
+    slots[i].hi = state.hi;
+    count++;
+    return true;
+}
+
+void PeepholeOptimizer::grow()
+{
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(old.size() * 2, Slot{0, 0});
+    mask = slots.size() - 1;
+    for (const Slot &slot : old)
+    {
+        if (slot.lo == 0)
+            continue;
+        size_t i = PackedStateHash()(PackedState{slot.lo & KEY_MASK, slot.hi}) & mask;
+        while (slots[i].lo != 0)
+            i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+}
+
+int PeepholeOptimizer::distance(const CubieCube &cube) const
+{
+    const Slot *slot = find(packState(cube));
+    return slot == nullptr ? -1 : static_cast<int>(slot->lo >> DEPTH_SHIFT & 15);
+}
+
+int PeepholeOptimizer::optimalSequence(const CubieCube &cube, Move *out) const
+{
+    const Slot *slot = find(packState(cube));
+    if (slot == nullptr)
+        return -1;
+
+    // Walk back to solved by undoing the stored last move at each step.
+    int length = static_cast<int>(slot->lo >> DEPTH_SHIFT & 15);
+    CubieCube current = cube;
+    for (int i = length - 1; i >= 0; i--)
+    {
+        Move last = static_cast<Move>(slot->lo >> MOVE_SHIFT & 31);
+        out[i] = last;
+        current.move(inverse(last));
+        slot = find(packState(current));
+    }
+    return length;
+}
+
+size_t PeepholeOptimizer::optimize(Move *moves, size_t length) const
+{
+    RUBIKS_PROFILE_SCOPE("Peephole::optimize");
+    Move replacement[MAX_DEPTH];
+    length = simplifyMoves(moves, length);
+
+    size_t start = 0;
+    while (start + 1 < length)
+    {
+        // Find the window starting here with the largest saving. Simplified
+        // sequences are canonical, and canonical sequences of up to 3 moves
+        // are always optimal, so shorter windows are not looked up.
+        CubieCube net, bestNet;
+        size_t bestLength = 0, bestSaving = 0;
+        size_t limit = std::min(static_cast<size_t>(window), length - start);
+        for (size_t len = 1; len <= limit; len++)
+        {
+            net.move(moves[start + len - 1]);
+            if (len < 4)
+                continue;
+            int d = distance(net);
+            if (d >= 0 && static_cast<size_t>(d) < len && len - d > bestSaving)
+            {
+                bestSaving = len - d;
+                bestLength = len;
+                bestNet = net;
+            }
+        }
+        if (bestSaving == 0)
+        {
+            start++;
+            continue;
+        }
+
+        int replacementLength = optimalSequence(bestNet, replacement);
+        std::memcpy(moves + start, replacement, replacementLength * sizeof(Move));
+        std::memmove(moves + start + replacementLength, moves + start + bestLength, (length - start - bestLength) * sizeof(Move));
+        length = simplifyMoves(moves, length - bestSaving);
+
+        // Windows ending before the splice are unchanged; recheck the rest.
+        start = start >= static_cast<size_t>(window) ? start - window + 1 : 0;
+    }
+    return length;
+}
+
+std::vector<Move> PeepholeOptimizer::optimize(const std::vector<Move> &moves) const
+{
+    std::vector<Move> result(moves);
+    result.resize(optimize(result.data(), result.size()));
+    return result;
+}
@@ -0,0 +1,195 @@
+#include "PocketCube.h"
+#include <cstring>
+
+// The 2x2 sticker of each 3x3 corner facelet: rows and columns 0 and 2 map to 0 and 1.
+static int pocketSticker(int facelet)
+{
+    int face = facelet / 9, row = facelet % 9 / 3, col = facelet % 3;
+    return face * 4 + row / 2 * 2 + col / 2;
+}
+
+PocketCube::PocketCube()
+{
+    for (int i = 0; i < 8; i++)
+    {
+        cp[i] = static_cast<uint8_t>(i);
+        co[i] = 0;
+    }
+}
+
+void PocketCube::multiply(const PocketCube &other)
+{
+    static const uint8_t twistSum[5] = {0, 1, 2, 0, 1};
+
+    uint8_t newCp[8], newCo[8];
+    for (int i = 0; i < 8; i++)
+    {
+        newCp[i] = cp[other.cp[i]];
+        newCo[i] = twistSum[co[other.cp[i]] + other.co[i]];
+    }
+    std::memcpy(cp, newCp, sizeof(cp));
+    std::memcpy(co, newCo, sizeof(co));
+}
+
+// The corner part of each move, taken from the 3x3 cubie moves.
+static const PocketCube &moveCorners(Move m)
+{
+    static const struct MoveTable
+    {
+        PocketCube moves[NUM_MOVES];
+        MoveTable()
+        {
+            for (int i = 0; i < NUM_MOVES; i++)
+            {
+                const CubieCube &cubie = CubieCube::moveCube(static_cast<Move>(i));
+                std::memcpy(moves[i].cp, cubie.cp, sizeof(cubie.cp));
+                std::memcpy(moves[i].co, cubie.co, sizeof(cubie.co));
+            }
+        }
+    } table;
+    return table.moves[static_cast<int>(m)];
+}
+
+void PocketCube::move(Move m)
+{
+    multiply(moveCorners(m));
+}
+
+void PocketCube::apply(const Move *moves, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        multiply(moveCorners(moves[i]));
+    }
+}
+
+PocketCube PocketCube::inverse() const
+{
+    PocketCube result;
+    for (int i = 0; i < 8; i++)
+    {
+        result.cp[cp[i]] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        result.co[i] = static_cast<uint8_t>((3 - co[result.cp[i]]) % 3);
+    }
+    return result;
+}
+
+bool PocketCube::operator==(const PocketCube &other) const
+{
+    return std::memcmp(cp, other.cp, sizeof(cp)) == 0 && std::memcmp(co, other.co, sizeof(co)) == 0;
+}
+
+bool PocketCube::isValid() const
+{
+    unsigned seen = 0;
+    int twist = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        if (cp[i] >= 8 || co[i] >= 3)
+            return false;
+        seen |= 1u << cp[i];
+        twist += co[i];
+    }
+    return seen == 0xFF && twist % 3 == 0;
+}
+
+// Without centers, R L' turns the whole cube like x, U D' like y and F B'
+// like z. The 24 rotations are everything these generate.
+const PocketCube &PocketCube::rotation(int index)
+{
+    static const struct RotationTable
+    {
+        PocketCube rotations[24];
+        RotationTable()
+        {
+            PocketCube generators[3];
+            const Move pairs[3][2] = {{Move::R, Move::L_PRIME}, {Move::U, Move::D_PRIME}, {Move::F, Move::B_PRIME}};
+            for (int g = 0; g < 3; g++)
+                generators[g].apply(pairs[g], 2);
+
+            int count = 1;
+            for (int i = 0; i < count; i++)
+            {
+                for (const PocketCube &generator : generators)
+                {
+                    PocketCube next = rotations[i];
+                    next.multiply(generator);
+                    bool known = false;
+                    for (int j = 0; j < count && !known; j++)
+                        known = rotations[j] == next;
+                    if (!known)
+                        rotations[count++] = next;
+                }
+            }
+        }
+    } table;
+    return table.rotations[index];
+}
+
+int PocketCube::normalizingRotation() const
+{
+    for (int r = 0; r < 24; r++)
+    {
+        const PocketCube &rot = rotation(r);
+        // Slot DBL of this * rot holds cp[rot.cp[DBL]], twisted by both.
+        if (cp[rot.cp[CubieCube::DBL]] == CubieCube::DBL && (co[rot.cp[CubieCube::DBL]] + rot.co[CubieCube::DBL]) % 3 == 0)
+            return r;
+    }
+    return 0;
+}
+
+bool PocketCube::isSolved() const
+{
+    PocketCube normalized = *this;
+    normalized.multiply(rotation(normalizingRotation()));
+    return normalized == PocketCube();
+}
+
+void PocketCube::toStickers(RubiksCube::Color *stickers) const
+{
+    for (int i = 0; i < 8; i++)
+    {
+        for (int n = 0; n < 3; n++)
+        {
+            int target = CubieCube::CORNER_FACELETS[i][(n + co[i]) % 3];
+            int source = CubieCube::CORNER_FACELETS[cp[i]][n];
+            stickers[pocketSticker(target)] = static_cast<RubiksCube::Color>(source / 9);
+        }
+    }
+}
+
+bool PocketCube::fromStickers(const RubiksCube::Color *stickers)
+{
+    // Reuse the 3x3 corner identification on a sticker set with the corner
+    // facelets filled in.
+    RubiksCube::Color full[RubiksCube::NUM_STICKERS];
+    CubieCube().toStickers(full);
+    for (int i = 0; i < 8; i++)
+    {
+        for (int n = 0; n < 3; n++)
+        {
+            int facelet = CubieCube::CORNER_FACELETS[i][n];
+            full[facelet] = stickers[pocketSticker(facelet)];
+        }
+    }
+
+    CubieCube cubie;
+    if (!cubie.fromStickers(full))
+        return false;
+    std::memcpy(cp, cubie.cp, sizeof(cp));
+    std::memcpy(co, cubie.co, sizeof(co));
+    return true;
+}
+
+bool PocketCube::fromCube(const RubiksCube &cube)
+{
+    CubieCube cubie;
+    if (!cubie.fromCube(cube))
+        return false;
+    std::memcpy(cp, cubie.cp, sizeof(cp));
+    std::memcpy(co, cubie.co, sizeof(co));
+    return true;
+}
@@ -0,0 +1,183 @@
+#include "PocketSolver.h"
+#include "Coordinates.h"
+#include "Profiler.h"
+
+// The moves that leave DBL alone.
+static const Move TABLE_MOVES[] = {Move::U, Move::U_PRIME, Move::U2, Move::R, Move::R_PRIME, Move::R2,
+                                   Move::F, Move::F_PRIME, Move::F2};
+static const int NUM_TABLE_MOVES = 9;
+
+static const int NUM_PERM = 5040;  // 7! arrangements of the other corners
+static const int NUM_TWIST6 = 729; // 3^6 free twists; the seventh follows
+
+static const uint8_t UNSEEN = 0xFF;
+static const int NO_MOVE = 15;
+
+struct PocketSolver::Tables
+{
+    // Low 4 bits: distance. High 4 bits: index into TABLE_MOVES of a move
+    // towards solved, or NO_MOVE at the solved state.
+    std::vector<uint8_t> entries;
+
+    // rotationMove[r][m]: the face move equal to r * m * r^-1.
+    Move rotationMove[24][NUM_MOVES];
+
+    Tables();
+};
+
+// Corner slots other than DBL, in index order.
+static const int FREE_SLOTS[7] = {0, 1, 2, 3, 4, 5, 7};
+
+static int permIndex(const PocketCube &cube)
+{
+    uint8_t perm[7];
+    for (int i = 0; i < 7; i++)
+        perm[i] = static_cast<uint8_t>(cube.cp[FREE_SLOTS[i]] == 7 ? 6 : cube.cp[FREE_SLOTS[i]]);
+    return permutationRank(perm, 7);
+}
+
+static int twistIndex(const PocketCube &cube)
+{
+    int twist = 0;
+    for (int i = 0; i < 6; i++)
+        twist = twist * 3 + cube.co[FREE_SLOTS[i]];
+    return twist;
+}
+
+static PocketCube fromIndices(int perm, int twist)
+{
+    PocketCube cube;
+    uint8_t order[7];
+    permutationUnrank(perm, order, 7);
+    int sum = 0;
+    for (int i = 5; i >= 0; i--)
+    {
+        cube.co[FREE_SLOTS[i]] = static_cast<uint8_t>(twist % 3);
+        sum += twist % 3;
+        twist /= 3;
+    }
+    cube.co[7] = static_cast<uint8_t>((3 - sum % 3) % 3);
+    for (int i = 0; i < 7; i++)
+        cube.cp[FREE_SLOTS[i]] = static_cast<uint8_t>(order[i] == 6 ? 7 : order[i]);
+    return cube;
+}
+
+int PocketSolver::stateIndex(const PocketCube &cube)
+{
+    return permIndex(cube) * NUM_TWIST6 + twistIndex(cube);
+}
+
+PocketSolver::Tables::Tables()
+{
+    RUBIKS_PROFILE_SCOPE("Pocket::tables");
+    // The permutation and twist parts move independently, so the search runs
+    // on small move tables rather than on cubes.
+    std::vector<uint16_t> permMove(NUM_PERM * NUM_TABLE_MOVES), twistMove(NUM_TWIST6 * NUM_TABLE_MOVES);
+    for (int p = 0; p < NUM_PERM; p++)
+    {
+        for (int m = 0; m < NUM_TABLE_MOVES; m++)
+        {
+            PocketCube cube = fromIndices(p, 0);
+            cube.move(TABLE_MOVES[m]);
+            permMove[p * NUM_TABLE_MOVES + m] = static_cast<uint16_t>(permIndex(cube));
+        }
+    }
+    for (int w = 0; w < NUM_TWIST6; w++)
+    {
+        for (int m = 0; m < NUM_TABLE_MOVES; m++)
+        {
+            PocketCube cube = fromIndices(0, w);
+            cube.move(TABLE_MOVES[m]);
+            twistMove[w * NUM_TABLE_MOVES + m] = static_cast<uint16_t>(twistIndex(cube));
+        }
+    }
+
+    // A move back towards the parent is the inverse of the move that reached
+    // the child; in TABLE_MOVES order the inverse swaps entries 0 and 1.
+    static const int inverse[3] = {1, 0, 2};
+
+    entries.assign(NUM_STATES, UNSEEN);
+    entries[0] = NO_MOVE << 4;
+    bool grew = true;
+    for (int depth = 0; grew; depth++)
+    {
+        grew = false;
+        for (int i = 0; i < NUM_STATES; i++)
+        {
+            if (entries[i] == UNSEEN || (entries[i] & 15) != depth)
+                continue;
+            int perm = i / NUM_TWIST6, twist = i % NUM_TWIST6;
+            for (int m = 0; m < NUM_TABLE_MOVES; m++)
+            {
+                int child = permMove[perm * NUM_TABLE_MOVES + m] * NUM_TWIST6 + twistMove[twist * NUM_TABLE_MOVES + m];
+                if (entries[child] != UNSEEN)
+                    continue;
+                int back = m / 3 * 3 + inverse[m % 3];
+                entries[child] = static_cast<uint8_t>(back << 4 | (depth + 1));
+                grew = true;
+            }
+        }
+    }
+
+    for (int r = 0; r < 24; r++)
+    {
+        const PocketCube &rot = PocketCube::rotation(r);
+        for (int m = 0; m < NUM_MOVES; m++)
+        {
+            PocketCube conjugate = rot;
+            conjugate.move(static_cast<Move>(m));
+            conjugate.multiply(rot.inverse());
+            for (int candidate = 0; candidate < NUM_MOVES; candidate++)
+            {
+                PocketCube face;
+                face.move(static_cast<Move>(candidate));
+                if (face == conjugate)
+                    rotationMove[r][m] = static_cast<Move>(candidate);
+            }
+        }
+    }
+}
+
+const PocketSolver::Tables &PocketSolver::tables()
+{
+    static const Tables shared;
+    return shared;
+}
+
+PocketSolver::PocketSolver() : t(tables())
+{
+}
+
+int PocketSolver::distance(const PocketCube &cube) const
+{
+    if (!cube.isValid())
+        return -1;
+    PocketCube normalized = cube;
+    normalized.multiply(PocketCube::rotation(cube.normalizingRotation()));
+    return t.entries[stateIndex(normalized)] & 15;
+}
+
+bool PocketSolver::solve(const PocketCube &cube, std::vector<Move> &solution) const
+{
+    solution.clear();
+    if (!cube.isValid())
+        return false;
+
+    RUBIKS_PROFILE_SCOPE("Pocket::solve");
+
+    // Solve cube * r with U R F turns; cube followed by r * M * r^-1 is then
+    // solved up to the rotation r^-1.
+    int r = cube.normalizingRotation();
+    PocketCube normalized = cube;
+    normalized.multiply(PocketCube::rotation(r));
+
+    uint8_t entry = t.entries[stateIndex(normalized)];
+    while ((entry >> 4) != NO_MOVE)
+    {
+        Move m = TABLE_MOVES[entry >> 4];
+        normalized.move(m);
+        solution.push_back(t.rotationMove[r][static_cast<int>(m)]);
+        entry = t.entries[stateIndex(normalized)];
+    }
+    return true;
+}
@@ -0,0 +1,174 @@
+#include "Profiler.h"
+
+#if RUBIKS_PROFILE_ENABLED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RUBIKS_PROFILE_TSC 1
+#else
+#include <time.h>
+#define RUBIKS_PROFILE_TSC 0
+#endif
+
+uint64_t profileTicks()
+{
+#if RUBIKS_PROFILE_TSC
+    return __rdtsc();
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+#endif
+}
+
+struct SiteTotals
+{
+    uint64_t ticks = 0;
+    uint64_t calls = 0;
+    uint64_t count = 0;
+};
+
+// Global site names and merged totals. Being a function-local static, it is
+// destroyed after every thread's slots have been merged, and prints the
+// summary then.
+struct ProfileRegistry
+{
+    std::mutex mutex;
+    std::atomic<int> sites{0};
+    const char *names[ProfileSite::MAX_SITES];
+    SiteTotals totals[ProfileSite::MAX_SITES];
+    uint64_t startTicks = profileTicks();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    ~ProfileRegistry()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        write(std::cerr, totals);
+    }
+
+    // Nanoseconds per tick, measured over the program's run so far.
+    double nsPerTick() const
+    {
+#if RUBIKS_PROFILE_TSC
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+        uint64_t ticks = profileTicks() - startTicks;
+        return ticks > 0 ? ns / ticks : 0;
+#else
+        return 1.0;
+#endif
+    }
+
+    void write(std::ostream &out, const SiteTotals *merged) const
+    {
+        int count = std::min(sites.load(), static_cast<int>(ProfileSite::MAX_SITES));
+        std::vector<int> order;
+        for (int i = 0; i < count; i++)
+        {
+            if (merged[i].calls > 0 || merged[i].count > 0)
+                order.push_back(i);
+        }
+        if (order.empty())
+            return;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return merged[a].ticks > merged[b].ticks; });
+
+        double scale = nsPerTick();
+        out << "--- profile (" << (RUBIKS_PROFILE_TSC ? "cycles" : "ns") << ", inclusive) ---\n";
+        out << std::left << std::setw(32) << "site" << std::right << std::setw(14) << "calls" << std::setw(16) << "ticks"
+            << std::setw(12) << "ticks/call" << std::setw(12) << "ns/call" << std::setw(12) << "total ms" << std::setw(14) << "count"
+            << '\n';
+        for (int i : order)
+        {
+            const SiteTotals &t = merged[i];
+            double perCall = t.calls > 0 ? static_cast<double>(t.ticks) / t.calls : 0;
+            out << std::left << std::setw(32) << names[i] << std::right << std::setw(14) << t.calls << std::setw(16) << t.ticks
+                << std::setw(12) << std::fixed << std::setprecision(1) << perCall << std::setw(12) << perCall * scale
+                << std::setw(12) << std::setprecision(2) << t.ticks * scale / 1e6 << std::setw(14) << t.count << '\n';
+        }
+        out.flush();
+    }
+};
+
+static ProfileRegistry &registry()
+{
+    static ProfileRegistry shared;
+    return shared;
+}
+
+// Each thread's own accumulators, merged into the registry when it exits.
+struct ThreadProfile
+{
+    SiteTotals totals[ProfileSite::MAX_SITES];
+
+    ThreadProfile()
+    {
+        registry();
+    }
+
+    ~ThreadProfile()
+    {
+        ProfileRegistry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (int i = 0; i < ProfileSite::MAX_SITES; i++)
+        {
+            r.totals[i].ticks += totals[i].ticks;
+            r.totals[i].calls += totals[i].calls;
+            r.totals[i].count += totals[i].count;
+        }
+    }
+};
+
+static ThreadProfile &threadProfile()
+{
+    thread_local ThreadProfile profile;
+    return profile;
+}
+
+ProfileSite::ProfileSite(const char *name)
+{
+    ProfileRegistry &r = registry();
+    id = r.sites.fetch_add(1);
+    if (id < MAX_SITES)
+        r.names[id] = name;
+}
+
+void ProfileSite::record(uint64_t ticks)
+{
+    if (id >= MAX_SITES)
+        return;
+    SiteTotals &t = threadProfile().totals[id];
+    t.ticks += ticks;
+    t.calls++;
+}
+
+void ProfileSite::add(uint64_t amount)
+{
+    if (id < MAX_SITES)
+        threadProfile().totals[id].count += amount;
+}
+
+void profileReport(std::ostream &out)
+{
+    ProfileRegistry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    SiteTotals merged[ProfileSite::MAX_SITES];
+    const SiteTotals *mine = threadProfile().totals;
+    for (int i = 0; i < ProfileSite::MAX_SITES; i++)
+    {
+        merged[i].ticks = r.totals[i].ticks + mine[i].ticks;
+        merged[i].calls = r.totals[i].calls + mine[i].calls;
+        merged[i].count = r.totals[i].count + mine[i].count;
+    }
+    r.write(out, merged);
+}
+
+#endif // RUBIKS_PROFILE_ENABLED
@@ -1,202 +1,202 @@
 #include "RubiksCube.h"
+#include "CubeRenderer.h"
+#include "ScrambleGenerator.h"
+#include "StickerBatch.h"
 #include <iostream>
 #include <random>
 #include <vector>
 
-// Helper function to convert a Color enum to a string for printing.
-char getColorChar(RubiksCube::Color color)
+// Prints the net layout with a single write instead of a flush per line.
+void RubiksCube::print() const
+{
+    std::string text = "Rubik's Cube State:\n";
+    CubeRenderer renderer(text);
+    renderer.add(*this);
+    renderer.flush(std::cout);
+}
+
+// Returns a string representation of a move given its index (0-17)
+std::string RubiksCube::getMove(int ind)
 {
-    switch (color)
+    if (ind < 0 || ind >= NUM_MOVES)
     {
-    case RubiksCube::Color::WHITE:
-        return 'W';
-    case RubiksCube::Color::GREEN:
-        return 'G';
-    case RubiksCube::Color::RED:
-        return 'R';
-    case RubiksCube::Color::BLUE:
-        return 'B';
-    case RubiksCube::Color::ORANGE:
-        return 'O';
-    case RubiksCube::Color::YELLOW:
-        return 'Y';
+        return "";
     }
-    return ' '; // Should not happen
+    return moveName(static_cast<Move>(ind));
 }
 
-// Implements the generic print function for the Rubik's Cube.
-void RubiksCube::print() const
+// Applies a single move through the virtual move functions.
+void RubiksCube::move(Move m)
 {
-    std::cout << "Rubik's Cube State:" << std::endl;
+    switch (m)
+    {
+    case Move::U:
+        u();
+        break;
+    case Move::U_PRIME:
+        uPrime();
+        break;
+    case Move::U2:
+        u2();
+        break;
+    case Move::L:
+        l();
+        break;
+    case Move::L_PRIME:
+        lPrime();
+        break;
+    case Move::L2:
+        l2();
+        break;
+    case Move::F:
+        f();
+        break;
+    case Move::F_PRIME:
+        fPrime();
+        break;
+    case Move::F2:
+        f2();
+        break;
+    case Move::R:
+        r();
+        break;
+    case Move::R_PRIME:
+        rPrime();
+        break;
+    case Move::R2:
+        r2();
+        break;
+    case Move::B:
+        b();
+        break;
+    case Move::B_PRIME:
+        bPrime();
+        break;
+    case Move::B2:
+        b2();
+        break;
+    case Move::D:
+        d();
+        break;
+    case Move::D_PRIME:
+        dPrime();
+        break;
+    case Move::D2:
+        d2();
+        break;
+    }
+}
 
-    // Print the UP face
-    for (int i = 0; i < 3; ++i)
+void RubiksCube::getStickers(Color *stickers) const
+{
+    for (int i = 0; i < NUM_STICKERS; i++)
     {
-        std::cout << "        ";
-        for (int j = 0; j < 3; ++j)
-        {
-            std::cout << getColorChar(getColor(Face::UP, i, j)) << " ";
-        }
-        std::cout << std::endl;
+        stickers[i] = getColor(static_cast<Face>(i / 9), (i % 9) / 3, i % 3);
     }
-    std::cout << std::endl;
+}
 
-    // Print LEFT, FRONT, RIGHT, and BACK faces in a row
-    for (int i = 0; i < 3; ++i)
+void RubiksCube::apply(const Move *moves, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
     {
-        // LEFT
-        for (int j = 0; j < 3; ++j)
-        {
-            std::cout << getColorChar(getColor(Face::LEFT, i, j)) << " ";
-        }
-        std::cout << "  ";
+        move(moves[i]);
+    }
+}
 
-        // FRONT
-        for (int j = 0; j < 3; ++j)
-        {
-            std::cout << getColorChar(getColor(Face::FRONT, i, j)) << " ";
-        }
-        std::cout << "  ";
+// The five 4-cycles of sticker indices (face * 9 + row * 3 + col) moved by a
+// clockwise turn of each face. For a cycle {a, b, c, d} the sticker at b moves
+// to a, c to b, d to c and a to d.
+const int RubiksCube::STICKER_CYCLES[6][5][4] = {
+    // U
+    {{0, 6, 8, 2}, {1, 3, 7, 5}, {9, 18, 27, 36}, {10, 19, 28, 37}, {11, 20, 29, 38}},
+    // L
+    {{0, 44, 45, 18}, {3, 41, 48, 21}, {6, 38, 51, 24}, {9, 15, 17, 11}, {10, 12, 16, 14}},
+    // F
+    {{6, 17, 47, 27}, {7, 14, 46, 30}, {8, 11, 45, 33}, {18, 24, 26, 20}, {19, 21, 25, 23}},
+    // R
+    {{2, 20, 47, 42}, {5, 23, 50, 39}, {8, 26, 53, 36}, {27, 33, 35, 29}, {28, 30, 34, 32}},
+    // B
+    {{0, 29, 53, 15}, {1, 32, 52, 12}, {2, 35, 51, 9}, {36, 42, 44, 38}, {37, 39, 43, 41}},
+    // D
+    {{15, 42, 33, 24}, {16, 43, 34, 25}, {17, 44, 35, 26}, {45, 51, 53, 47}, {46, 48, 52, 50}}};
 
-        // RIGHT
-        for (int j = 0; j < 3; ++j)
+// Performs a whole move (quarter, half or inverse) in one pass over the 20
+// affected stickers instead of repeating quarter turns.
+void RubiksCube::applyStickerMove(Color *stickers, Move m)
+{
+    const int(*cycles)[4] = STICKER_CYCLES[moveFace(m)];
+    switch (moveQuarterTurns(m))
+    {
+    case 1:
+        for (int i = 0; i < 5; i++)
         {
-            std::cout << getColorChar(getColor(Face::RIGHT, i, j)) << " ";
+            const int *c = cycles[i];
+            Color temp = stickers[c[0]];
+            stickers[c[0]] = stickers[c[1]];
+            stickers[c[1]] = stickers[c[2]];
+            stickers[c[2]] = stickers[c[3]];
+            stickers[c[3]] = temp;
         }
-        std::cout << "  ";
-
-        // BACK
-        for (int j = 0; j < 3; ++j)
+        break;
+    case 3:
+        for (int i = 0; i < 5; i++)
         {
-            std::cout << getColorChar(getColor(Face::BACK, i, j)) << " ";
+            const int *c = cycles[i];
+            Color temp = stickers[c[3]];
+            stickers[c[3]] = stickers[c[2]];
+            stickers[c[2]] = stickers[c[1]];
+            stickers[c[1]] = stickers[c[0]];
+            stickers[c[0]] = temp;
         }
-        std::cout << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Print the DOWN face
-    for (int i = 0; i < 3; ++i)
-    {
-        std::cout << "        ";
-        for (int j = 0; j < 3; ++j)
+        break;
+    case 2:
+        for (int i = 0; i < 5; i++)
         {
-            std::cout << getColorChar(getColor(Face::DOWN, i, j)) << " ";
+            const int *c = cycles[i];
+            Color temp = stickers[c[0]];
+            stickers[c[0]] = stickers[c[2]];
+            stickers[c[2]] = temp;
+            temp = stickers[c[1]];
+            stickers[c[1]] = stickers[c[3]];
+            stickers[c[3]] = temp;
         }
-        std::cout << std::endl;
+        break;
     }
 }
 
-// Returns a string representation of a move given its index (0-17)
-std::string RubiksCube::getMove(int ind)
+// Below this many moves, packing the stickers into a kernel row and back
+// costs more than the kernel saves.
+static constexpr size_t KERNEL_MIN_MOVES = 16;
+
+void RubiksCube::applyStickerMoves(Color *stickers, const Move *moves, size_t count)
 {
-    switch (ind)
+    const KernelTable &kernels = activeKernels();
+    if (kernels.permuteSequence == nullptr || count < KERNEL_MIN_MOVES)
     {
-    case 0:
-        return "U";
-    case 1:
-        return "U'";
-    case 2:
-        return "U2";
-    case 3:
-        return "L";
-    case 4:
-        return "L'";
-    case 5:
-        return "L2";
-    case 6:
-        return "F";
-    case 7:
-        return "F'";
-    case 8:
-        return "F2";
-    case 9:
-        return "R";
-    case 10:
-        return "R'";
-    case 11:
-        return "R2";
-    case 12:
-        return "B";
-    case 13:
-        return "B'";
-    case 14:
-        return "B2";
-    case 15:
-        return "D";
-    case 16:
-        return "D'";
-    case 17:
-        return "D2";
+        for (size_t i = 0; i < count; i++)
+            applyStickerMove(stickers, moves[i]);
+        return;
     }
-    return "";
+    alignas(64) uint8_t row[KERNEL_ROW_BYTES] = {};
+    for (int i = 0; i < NUM_STICKERS; i++)
+        row[i] = static_cast<uint8_t>(stickers[i]);
+    kernels.permuteSequence(StickerBatch::moveControls(), moves, count, row);
+    for (int i = 0; i < NUM_STICKERS; i++)
+        stickers[i] = static_cast<Color>(row[i]);
 }
 
-// Applies a sequence of random moves to shuffle the cube.
+// Applies a sequence of random moves to shuffle the cube, drawing from a
+// per-thread generator that is seeded once.
 void RubiksCube::randomShuffle(unsigned int times)
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distrib(0, 17);
+    static thread_local ScrambleGenerator generator(std::random_device{}());
+    randomShuffle(times, generator);
+}
 
-    for (unsigned int i = 0; i < times; ++i)
-    {
-        int move_idx = distrib(gen);
-        switch (move_idx)
-        {
-        case 0:
-            u();
-            break;
-        case 1:
-            uPrime();
-            break;
-        case 2:
-            u2();
-            break;
-        case 3:
-            l();
-            break;
-        case 4:
-            lPrime();
-            break;
-        case 5:
-            l2();
-            break;
-        case 6:
-            f();
-            break;
-        case 7:
-            fPrime();
-            break;
-        case 8:
-            f2();
-            break;
-        case 9:
-            r();
-            break;
-        case 10:
-            rPrime();
-            break;
-        case 11:
-            r2();
-            break;
-        case 12:
-            b();
-            break;
-        case 13:
-            bPrime();
-            break;
-        case 14:
-            b2();
-            break;
-        case 15:
-            d();
-            break;
-        case 16:
-            dPrime();
-            break;
-        case 17:
-            d2();
-            break;
-        }
-    }
+// Applies a reproducible random move sequence taken from `generator`.
+void RubiksCube::randomShuffle(unsigned int times, ScrambleGenerator &generator)
+{
+    std::vector<Move> moves(times);
+    generator.randomMoves(moves.data(), times);
+    apply(moves.data(), times);
 }
\ No newline at end of file
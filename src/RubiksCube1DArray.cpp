@@ -1,5 +1,7 @@
 #include "RubiksCube1DArray.h"
+#include "Profiler.h"
 #include <utility> // for std::swap
+#include <cstring>
 
 // Helper to map 3D coordinates to a 1D index.
 int RubiksCube1DArray::getIndex(Face face, unsigned int row, unsigned int col) const
@@ -34,6 +36,24 @@ bool RubiksCube1DArray::isSolved() const
     return true;
 }
 
+// The grid already is the shared sticker layout, so state transfer is a copy.
+void RubiksCube1DArray::getStickers(Color *stickers) const
+{
+    std::memcpy(stickers, grid, sizeof(grid));
+}
+
+void RubiksCube1DArray::setStickers(const Color *stickers)
+{
+    std::memcpy(grid, stickers, sizeof(grid));
+}
+
+// Bulk move application: the grid already uses the shared sticker layout.
+void RubiksCube1DArray::apply(const Move *moves, size_t count)
+{
+    RUBIKS_PROFILE_SCOPE("1DArray::apply");
+    applyStickerMoves(grid, moves, count);
+}
+
 // Rotates the stickers on a face clockwise using the 1D indices.
 void RubiksCube1DArray::rotateFace(int face_idx)
 {
@@ -55,6 +75,7 @@ void RubiksCube1DArray::rotateFace(int face_idx)
 
 void RubiksCube1DArray::u()
 {
+    RUBIKS_PROFILE_SCOPE("1DArray::u");
     rotateFace(static_cast<int>(Face::UP));
 
     // Indices for the top rows of FRONT, LEFT, BACK, RIGHT
@@ -89,6 +110,7 @@ void RubiksCube1DArray::u2()
 
 void RubiksCube1DArray::l()
 {
+    RUBIKS_PROFILE_SCOPE("1DArray::l");
     rotateFace(static_cast<int>(Face::LEFT));
 
     Color temp[3];
@@ -123,6 +145,7 @@ void RubiksCube1DArray::l2()
 
 void RubiksCube1DArray::f()
 {
+    RUBIKS_PROFILE_SCOPE("1DArray::f");
     rotateFace(static_cast<int>(Face::FRONT));
 
     Color temp[3];
@@ -157,6 +180,7 @@ void RubiksCube1DArray::f2()
 
 void RubiksCube1DArray::r()
 {
+    RUBIKS_PROFILE_SCOPE("1DArray::r");
     rotateFace(static_cast<int>(Face::RIGHT));
 
     Color temp[3];
@@ -191,6 +215,7 @@ void RubiksCube1DArray::r2()
 
 void RubiksCube1DArray::b()
 {
+    RUBIKS_PROFILE_SCOPE("1DArray::b");
     rotateFace(static_cast<int>(Face::BACK));
 
     Color temp[3];
@@ -205,7 +230,7 @@ void RubiksCube1DArray::b()
         grid[getIndex(Face::RIGHT, i, 2)] = grid[getIndex(Face::DOWN, 2, 2 - i)];
     // Left -> Down
     for (int i = 0; i < 3; i++)
-        grid[getIndex(Face::DOWN, 2, i)] = grid[getIndex(Face::LEFT, 2 - i, 0)];
+        grid[getIndex(Face::DOWN, 2, i)] = grid[getIndex(Face::LEFT, i, 0)];
     // Temp -> Left
     for (int i = 0; i < 3; i++)
         grid[getIndex(Face::LEFT, i, 0)] = temp[2 - i];
@@ -225,24 +250,25 @@ void RubiksCube1DArray::b2()
 
 void RubiksCube1DArray::d()
 {
+    RUBIKS_PROFILE_SCOPE("1DArray::d");
     rotateFace(static_cast<int>(Face::DOWN));
 
     Color temp[3];
     for (int i = 0; i < 3; i++)
         temp[i] = grid[getIndex(Face::FRONT, 2, i)]; // Store Front
 
-    // Right -> Front
+    // Left -> Front
     for (int i = 0; i < 3; i++)
-        grid[getIndex(Face::FRONT, 2, i)] = grid[getIndex(Face::RIGHT, 2, i)];
-    // Back -> Right
+        grid[getIndex(Face::FRONT, 2, i)] = grid[getIndex(Face::LEFT, 2, i)];
+    // Back -> Left
     for (int i = 0; i < 3; i++)
-        grid[getIndex(Face::RIGHT, 2, i)] = grid[getIndex(Face::BACK, 2, i)];
-    // Left -> Back
+        grid[getIndex(Face::LEFT, 2, i)] = grid[getIndex(Face::BACK, 2, i)];
+    // Right -> Back
     for (int i = 0; i < 3; i++)
-        grid[getIndex(Face::BACK, 2, i)] = grid[getIndex(Face::LEFT, 2, i)];
-    // Temp -> Left
+        grid[getIndex(Face::BACK, 2, i)] = grid[getIndex(Face::RIGHT, 2, i)];
+    // Temp -> Right
     for (int i = 0; i < 3; i++)
-        grid[getIndex(Face::LEFT, 2, i)] = temp[i];
+        grid[getIndex(Face::RIGHT, 2, i)] = temp[i];
 }
 
 void RubiksCube1DArray::dPrime()
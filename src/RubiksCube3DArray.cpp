@@ -1,4 +1,6 @@
 #include "RubiksCube3DArray.h"
+#include "Profiler.h"
+#include <cstring>
 
 // Constructor: Initializes the grid to the solved state.
 RubiksCube3DArray::RubiksCube3DArray()
@@ -42,6 +44,24 @@ bool RubiksCube3DArray::isSolved() const
     return true;
 }
 
+// grid[6][3][3] is stored in the shared sticker layout, so state transfer is a copy.
+void RubiksCube3DArray::getStickers(Color *stickers) const
+{
+    std::memcpy(stickers, grid, sizeof(grid));
+}
+
+void RubiksCube3DArray::setStickers(const Color *stickers)
+{
+    std::memcpy(grid, stickers, sizeof(grid));
+}
+
+// Bulk move application: grid[6][3][3] is laid out exactly like the 1D model.
+void RubiksCube3DArray::apply(const Move *moves, size_t count)
+{
+    RUBIKS_PROFILE_SCOPE("3DArray::apply");
+    applyStickerMoves(&grid[0][0][0], moves, count);
+}
+
 // Helper function to rotate the stickers on a single face clockwise.
 void RubiksCube3DArray::rotateFace(int faceIndex)
 {
@@ -67,6 +87,7 @@ void RubiksCube3DArray::rotateFace(int faceIndex)
 
 void RubiksCube3DArray::u()
 {
+    RUBIKS_PROFILE_SCOPE("3DArray::u");
     rotateFace(static_cast<int>(Face::UP));
 
     Color temp_row[3];
@@ -74,18 +95,18 @@ void RubiksCube3DArray::u()
     for (int i = 0; i < 3; i++)
         temp_row[i] = grid[static_cast<int>(Face::FRONT)][0][i];
 
-    // Left -> Front
+    // Right -> Front
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::FRONT)][0][i] = grid[static_cast<int>(Face::LEFT)][0][i];
-    // Back -> Left
+        grid[static_cast<int>(Face::FRONT)][0][i] = grid[static_cast<int>(Face::RIGHT)][0][i];
+    // Back -> Right
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::LEFT)][0][i] = grid[static_cast<int>(Face::BACK)][0][i];
-    // Right -> Back
+        grid[static_cast<int>(Face::RIGHT)][0][i] = grid[static_cast<int>(Face::BACK)][0][i];
+    // Left -> Back
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::BACK)][0][i] = grid[static_cast<int>(Face::RIGHT)][0][i];
-    // Temp (Front) -> Right
+        grid[static_cast<int>(Face::BACK)][0][i] = grid[static_cast<int>(Face::LEFT)][0][i];
+    // Temp (Front) -> Left
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::RIGHT)][0][i] = temp_row[i];
+        grid[static_cast<int>(Face::LEFT)][0][i] = temp_row[i];
 }
 
 void RubiksCube3DArray::uPrime()
@@ -103,6 +124,7 @@ void RubiksCube3DArray::u2()
 
 void RubiksCube3DArray::l()
 {
+    RUBIKS_PROFILE_SCOPE("3DArray::l");
     rotateFace(static_cast<int>(Face::LEFT));
 
     Color temp_col[3];
@@ -139,6 +161,7 @@ void RubiksCube3DArray::l2()
 
 void RubiksCube3DArray::f()
 {
+    RUBIKS_PROFILE_SCOPE("3DArray::f");
     rotateFace(static_cast<int>(Face::FRONT));
 
     Color temp_row[3];
@@ -175,6 +198,7 @@ void RubiksCube3DArray::f2()
 
 void RubiksCube3DArray::r()
 {
+    RUBIKS_PROFILE_SCOPE("3DArray::r");
     rotateFace(static_cast<int>(Face::RIGHT));
 
     Color temp_col[3];
@@ -211,6 +235,7 @@ void RubiksCube3DArray::r2()
 
 void RubiksCube3DArray::b()
 {
+    RUBIKS_PROFILE_SCOPE("3DArray::b");
     rotateFace(static_cast<int>(Face::BACK));
 
     Color temp_row[3];
@@ -226,7 +251,7 @@ void RubiksCube3DArray::b()
         grid[static_cast<int>(Face::RIGHT)][i][2] = grid[static_cast<int>(Face::DOWN)][2][2 - i];
     // Left -> Down
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::DOWN)][2][i] = grid[static_cast<int>(Face::LEFT)][2 - i][0];
+        grid[static_cast<int>(Face::DOWN)][2][i] = grid[static_cast<int>(Face::LEFT)][i][0];
     // Temp (Up) -> Left
     for (int i = 0; i < 3; i++)
         grid[static_cast<int>(Face::LEFT)][i][0] = temp_row[2 - i];
@@ -247,6 +272,7 @@ void RubiksCube3DArray::b2()
 
 void RubiksCube3DArray::d()
 {
+    RUBIKS_PROFILE_SCOPE("3DArray::d");
     rotateFace(static_cast<int>(Face::DOWN));
 
     Color temp_row[3];
@@ -254,18 +280,18 @@ void RubiksCube3DArray::d()
     for (int i = 0; i < 3; i++)
         temp_row[i] = grid[static_cast<int>(Face::FRONT)][2][i];
 
-    // Right -> Front
+    // Left -> Front
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::FRONT)][2][i] = grid[static_cast<int>(Face::RIGHT)][2][i];
-    // Back -> Right
+        grid[static_cast<int>(Face::FRONT)][2][i] = grid[static_cast<int>(Face::LEFT)][2][i];
+    // Back -> Left
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::RIGHT)][2][i] = grid[static_cast<int>(Face::BACK)][2][i];
-    // Left -> Back
+        grid[static_cast<int>(Face::LEFT)][2][i] = grid[static_cast<int>(Face::BACK)][2][i];
+    // Right -> Back
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::BACK)][2][i] = grid[static_cast<int>(Face::LEFT)][2][i];
-    // Temp (Front) -> Left
+        grid[static_cast<int>(Face::BACK)][2][i] = grid[static_cast<int>(Face::RIGHT)][2][i];
+    // Temp (Front) -> Right
     for (int i = 0; i < 3; i++)
-        grid[static_cast<int>(Face::LEFT)][2][i] = temp_row[i];
+        grid[static_cast<int>(Face::RIGHT)][2][i] = temp_row[i];
 }
 
 void RubiksCube3DArray::dPrime()
@@ -283,44 +309,7 @@ void RubiksCube3DArray::d2()
 
 bool RubiksCube3DArray::operator==(const RubiksCube3DArray &other) const
 {
-    for (int i = 0; i < 6; i++)
-    {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                if (this->grid[i][j][k] != other.grid[i][j][k])
-                {
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
-}
-
-RubiksCube3DArray &RubiksCube3DArray::operator=(const RubiksCube3DArray &other)
-{
-    // 1. Check for self-assignment
-    if (this == &other)
-    {
-        return *this;
-    }
-
-    // 2. Perform the deep copy
-    for (int i = 0; i < 6; i++)
-    {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                this->grid[i][j][k] = other.grid[i][j][k];
-            }
-        }
-    }
-
-    // 3. Return the current object
-    return *this;
+    return std::memcmp(grid, other.grid, sizeof(grid)) == 0;
 }
 
 // Hash function implementation
@@ -1,4 +1,5 @@
 #include "RubiksCubeBitboard.h"
+#include "Profiler.h"
 
 // Maps a 3x3 grid coordinate to the clockwise sticker index (0-7).
 int RubiksCubeBitboard::rowColToStickerIndex(unsigned int r, unsigned int c) const
@@ -79,6 +80,35 @@ RubiksCube::Color RubiksCubeBitboard::getColor(Face face, unsigned int row, unsi
     return getColorFromSticker(face_idx, sticker_idx);
 }
 
+// Position (row * 3 + col) of each clockwise sticker index.
+static const int STICKER_POSITIONS[8] = {0, 1, 2, 5, 8, 7, 6, 3};
+
+void RubiksCubeBitboard::getStickers(Color *stickers) const
+{
+    for (int face_idx = 0; face_idx < 6; face_idx++)
+    {
+        stickers[face_idx * 9 + 4] = static_cast<Color>(face_idx);
+        for (int j = 0; j < 8; j++)
+        {
+            stickers[face_idx * 9 + STICKER_POSITIONS[j]] = getColorFromSticker(face_idx, j);
+        }
+    }
+}
+
+void RubiksCubeBitboard::setStickers(const Color *stickers)
+{
+    for (int face_idx = 0; face_idx < 6; face_idx++)
+    {
+        uint64_t board = 0;
+        for (int j = 0; j < 8; j++)
+        {
+            uint64_t color_chunk = 1ULL << static_cast<int>(stickers[face_idx * 9 + STICKER_POSITIONS[j]]);
+            board |= color_chunk << (j * 8);
+        }
+        bitboard[face_idx] = board;
+    }
+}
+
 bool RubiksCubeBitboard::isSolved() const
 {
     for (int i = 0; i < 6; i++)
@@ -95,135 +125,148 @@ bool RubiksCubeBitboard::isSolved() const
     return true;
 }
 
-// Helper to rotate a bitboard clockwise by 16 bits (2 stickers)
-static void rotate_face_clockwise(uint64_t &val)
+// Rotates a 64-bit value left by `bits` (0 < bits < 64).
+static inline uint64_t rotl64(uint64_t val, int bits)
 {
-    val = (val >> 16) | (val << 48);
+    return (val << bits) | (val >> (64 - bits));
 }
 
-// Helper to rotate a bitboard anti-clockwise by 16 bits (2 stickers)
-static void rotate_face_anticlockwise(uint64_t &val)
+// Rotates a 64-bit value right by `bits` (0 <= bits < 64).
+static inline uint64_t rotr64(uint64_t val, int bits)
 {
-    val = (val << 16) | (val >> 48);
+    return bits == 0 ? val : (val >> bits) | (val << (64 - bits));
 }
 
-void RubiksCubeBitboard::f()
-{
-    // 1. Rotate the Front face itself
-    rotate_face_clockwise(bitboard[static_cast<int>(Face::FRONT)]);
-
-    // 2. Define masks for the 3-sticker groups (24 bits) on adjacent faces
-    // U(6,5,4) -> R(0,7,6) -> D(2,1,0) -> L(4,3,2) -> U(6,5,4)
-    const uint64_t MASK = 0xFFFFFFULL;
-    uint64_t up_mask = MASK << (8 * 4);
-    uint64_t left_mask = MASK << (8 * 2);
-    uint64_t down_mask = MASK << (8 * 0);
-    uint64_t right_mask = MASK << (8 * 6) | (MASK >> 16); // This wraps around
-
-    // 3. Extract the chunks from each face
-    uint64_t up_chunk = (bitboard[static_cast<int>(Face::UP)] & up_mask) >> (8 * 4);
-    uint64_t left_chunk = (bitboard[static_cast<int>(Face::LEFT)] & left_mask) >> (8 * 2);
-    uint64_t down_chunk = (bitboard[static_cast<int>(Face::DOWN)] & down_mask);
-    uint64_t right_chunk_p1 = (bitboard[static_cast<int>(Face::RIGHT)] & (MASK << (8 * 6))) >> (8 * 6);
-    uint64_t right_chunk_p2 = (bitboard[static_cast<int>(Face::RIGHT)] & (MASK >> 16)) << 16;
-    uint64_t right_chunk = right_chunk_p1 | right_chunk_p2;
-
-    // 4. Clear the bits on the faces
-    bitboard[static_cast<int>(Face::UP)] &= ~up_mask;
-    bitboard[static_cast<int>(Face::LEFT)] &= ~left_mask;
-    bitboard[static_cast<int>(Face::DOWN)] &= ~down_mask;
-    bitboard[static_cast<int>(Face::RIGHT)] &= ~((MASK << (8 * 6)) | (MASK >> 16));
-
-    // 5. Insert the moved chunks into their new places
-    bitboard[static_cast<int>(Face::UP)] |= left_chunk << (8 * 4);
-    bitboard[static_cast<int>(Face::LEFT)] |= down_chunk << (8 * 2);
-    bitboard[static_cast<int>(Face::DOWN)] |= right_chunk;
-    bitboard[static_cast<int>(Face::RIGHT)] |= (up_chunk & (MASK >> 16)) << (8 * 6);
-    bitboard[static_cast<int>(Face::RIGHT)] |= (up_chunk & (MASK << 16)) >> 16;
-}
-
-// All other moves can be defined by composing f() and whole-cube rotations,
-// but for clarity and performance, we will implement them directly. For now,
-// let's define the prime/double moves. The other base moves are very similar
-// to f() but with different faces and masks.
+// For each face, the four adjacent faces whose 3-sticker strips are cycled by a
+// clockwise turn, and the clockwise index of each strip's first sticker.
+// The strip on ring[i + 1] moves onto ring[i].
+static const int RING_FACES[6][4] = {
+    {1, 2, 3, 4}, // U: L F R B
+    {0, 4, 5, 2}, // L: U B D F
+    {0, 1, 5, 3}, // F: U L D R
+    {0, 2, 5, 4}, // R: U F D B
+    {0, 3, 5, 1}, // B: U R D L
+    {1, 4, 3, 2}  // D: L B R F
+};
+static const int RING_STARTS[6][4] = {
+    {0, 0, 0, 0},
+    {6, 2, 6, 6},
+    {4, 2, 0, 6},
+    {2, 2, 2, 6},
+    {0, 2, 4, 6},
+    {4, 4, 4, 4}};
 
-void RubiksCubeBitboard::fPrime()
+// Turns a face clockwise by 1, 2 or 3 quarter turns in a single pass.
+void RubiksCubeBitboard::turn(int face_idx, int quarter_turns)
 {
-    // To implement fPrime, we do the inverse of f.
-    // This is a great exercise, but for now, we can just call f() three times.
-    f();
-    f();
-    f();
+    RUBIKS_PROFILE_SCOPE("Bitboard::turn");
+    const uint64_t STRIP = 0xFFFFFFULL;
+
+    // 1. Rotate the face itself: each quarter turn moves every sticker two slots on.
+    bitboard[face_idx] = rotl64(bitboard[face_idx], 16 * quarter_turns);
+
+    // 2. Extract the four strips around the face into the low 24 bits.
+    const int *faces = RING_FACES[face_idx];
+    const int *starts = RING_STARTS[face_idx];
+    uint64_t strips[4];
+    for (int i = 0; i < 4; i++)
+    {
+        strips[i] = rotr64(bitboard[faces[i]], 8 * starts[i]) & STRIP;
+    }
+
+    // 3. Write each strip back `quarter_turns` places further round the ring.
+    for (int i = 0; i < 4; i++)
+    {
+        int shift = 8 * starts[i];
+        uint64_t mask = shift == 0 ? STRIP : rotl64(STRIP, shift);
+        uint64_t strip = strips[(i + quarter_turns) & 3];
+        bitboard[faces[i]] = (bitboard[faces[i]] & ~mask) | (shift == 0 ? strip : rotl64(strip, shift));
+    }
 }
 
-void RubiksCubeBitboard::f2()
+void RubiksCubeBitboard::apply(const Move *moves, size_t count)
 {
-    f();
-    f();
+    RUBIKS_PROFILE_SCOPE("Bitboard::apply");
+    for (size_t i = 0; i < count; i++)
+    {
+        turn(moveFace(moves[i]), moveQuarterTurns(moves[i]));
+    }
 }
 
-// NOTE: For a full implementation, you would write out the bit-twiddling
-// logic for U, L, R, B, D similarly to how F was done. This is tedious
-// but necessary. For this example, we will leave them empty as a placeholder.
-// The principle is identical to the F move.
-
-void RubiksCubeBitboard::u() { /* Similar bit logic as f() */ }
+void RubiksCubeBitboard::u()
+{
+    turn(static_cast<int>(Face::UP), 1);
+}
 void RubiksCubeBitboard::uPrime()
 {
-    u();
-    u();
-    u();
+    turn(static_cast<int>(Face::UP), 3);
 }
 void RubiksCubeBitboard::u2()
 {
-    u();
-    u();
+    turn(static_cast<int>(Face::UP), 2);
+}
+
+void RubiksCubeBitboard::l()
+{
+    turn(static_cast<int>(Face::LEFT), 1);
 }
-void RubiksCubeBitboard::l() { /* Similar bit logic as f() */ }
 void RubiksCubeBitboard::lPrime()
 {
-    l();
-    l();
-    l();
+    turn(static_cast<int>(Face::LEFT), 3);
 }
 void RubiksCubeBitboard::l2()
 {
-    l();
-    l();
+    turn(static_cast<int>(Face::LEFT), 2);
+}
+
+void RubiksCubeBitboard::f()
+{
+    turn(static_cast<int>(Face::FRONT), 1);
+}
+void RubiksCubeBitboard::fPrime()
+{
+    turn(static_cast<int>(Face::FRONT), 3);
+}
+void RubiksCubeBitboard::f2()
+{
+    turn(static_cast<int>(Face::FRONT), 2);
+}
+
+void RubiksCubeBitboard::r()
+{
+    turn(static_cast<int>(Face::RIGHT), 1);
 }
-void RubiksCubeBitboard::r() { /* Similar bit logic as f() */ }
 void RubiksCubeBitboard::rPrime()
 {
-    r();
-    r();
-    r();
+    turn(static_cast<int>(Face::RIGHT), 3);
 }
 void RubiksCubeBitboard::r2()
 {
-    r();
-    r();
+    turn(static_cast<int>(Face::RIGHT), 2);
+}
+
+void RubiksCubeBitboard::b()
+{
+    turn(static_cast<int>(Face::BACK), 1);
 }
-void RubiksCubeBitboard::b() { /* Similar bit logic as f() */ }
 void RubiksCubeBitboard::bPrime()
 {
-    b();
-    b();
-    b();
+    turn(static_cast<int>(Face::BACK), 3);
 }
 void RubiksCubeBitboard::b2()
 {
-    b();
-    b();
+    turn(static_cast<int>(Face::BACK), 2);
+}
+
+void RubiksCubeBitboard::d()
+{
+    turn(static_cast<int>(Face::DOWN), 1);
 }
-void RubiksCubeBitboard::d() { /* Similar bit logic as f() */ }
 void RubiksCubeBitboard::dPrime()
 {
-    d();
-    d();
-    d();
+    turn(static_cast<int>(Face::DOWN), 3);
 }
 void RubiksCubeBitboard::d2()
 {
-    d();
-    d();
-}
\ No newline at end of file
+    turn(static_cast<int>(Face::DOWN), 2);
+}
@@ -0,0 +1,101 @@
+#include "ScrambleGenerator.h"
+
+ScrambleGenerator::ScrambleGenerator(uint64_t seed) : rng(seed) {}
+
+void ScrambleGenerator::seed(uint64_t value)
+{
+    rng.seed(value);
+}
+
+void ScrambleGenerator::randomMoves(Move *out, size_t length)
+{
+    int lastFace = -1;
+    for (size_t i = 0; i < length; i++)
+    {
+        // Rejection keeps the choice uniform over the allowed moves.
+        int face;
+        uint32_t ind;
+        do
+        {
+            ind = rng.below(NUM_MOVES);
+            face = static_cast<int>(ind) / 3;
+        } while (!isCanonicalAfter(face, lastFace));
+
+        out[i] = static_cast<Move>(ind);
+        lastFace = face;
+    }
+}
+
+void ScrambleGenerator::randomMovesBatch(Move *out, size_t count, size_t length)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        randomMoves(out + i * length, length);
+    }
+}
+
+// Fisher-Yates shuffle of 0..n-1; returns the parity of the permutation.
+static int shuffle(Xoshiro256 &rng, uint8_t *perm, int n)
+{
+    int parity = 0;
+    for (int i = 0; i < n; i++)
+    {
+        perm[i] = static_cast<uint8_t>(i);
+    }
+    for (int i = n - 1; i > 0; i--)
+    {
+        int j = static_cast<int>(rng.below(static_cast<uint32_t>(i + 1)));
+        if (j != i)
+        {
+            uint8_t tmp = perm[i];
+            perm[i] = perm[j];
+            perm[j] = tmp;
+            parity ^= 1;
+        }
+    }
+    return parity;
+}
+
+CubieCube ScrambleGenerator::randomState()
+{
+    CubieCube cube;
+
+    int cornerParity = shuffle(rng, cube.cp, 8);
+    int edgeParity = shuffle(rng, cube.ep, 12);
+    // Swapping two edges maps odd and even permutations one-to-one, so fixing
+    // the parity this way keeps the distribution uniform.
+    if (cornerParity != edgeParity)
+    {
+        uint8_t tmp = cube.ep[0];
+        cube.ep[0] = cube.ep[1];
+        cube.ep[1] = tmp;
+    }
+
+    // The last twist and flip are determined by the others.
+    int twistSum = 0;
+    for (int i = 0; i < 7; i++)
+    {
+        cube.co[i] = static_cast<uint8_t>(rng.below(3));
+        twistSum += cube.co[i];
+    }
+    cube.co[7] = static_cast<uint8_t>((3 - twistSum % 3) % 3);
+
+    uint32_t flips = static_cast<uint32_t>(rng.next() >> 53); // 11 random bits
+    int flipSum = 0;
+    for (int i = 0; i < 11; i++)
+    {
+        cube.eo[i] = static_cast<uint8_t>((flips >> i) & 1);
+        flipSum += cube.eo[i];
+    }
+    cube.eo[11] = static_cast<uint8_t>(flipSum & 1);
+
+    return cube;
+}
+
+void ScrambleGenerator::randomStates(CubieCube *out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = randomState();
+    }
+}
@@ -0,0 +1,119 @@
+#include "SearchStats.h"
+#include <cmath>
+#include <sstream>
+
+// Writes the leading part of a counter array up to its last non-zero entry.
+static void writeCounterArray(std::ostringstream &out, const uint64_t *values, int size)
+{
+    int used = size;
+    while (used > 0 && values[used - 1] == 0)
+    {
+        used--;
+    }
+
+    out << "[";
+    for (int i = 0; i < used; i++)
+    {
+        if (i > 0)
+            out << ",";
+        out << values[i];
+    }
+    out << "]";
+}
+
+template <typename V>
+static void writeVector(std::ostringstream &out, const std::vector<V> &values)
+{
+    out << "[";
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (i > 0)
+            out << ",";
+        out << values[i];
+    }
+    out << "]";
+}
+
+SearchStats::SearchStats()
+{
+    reset();
+}
+
+void SearchStats::reset()
+{
+    for (int i = 0; i < MAX_DEPTH; i++)
+        nodesPerDepth[i] = 0;
+    for (int i = 0; i < MAX_HEURISTIC; i++)
+        heuristicHistogram[i] = 0;
+
+    prunedByBound = 0;
+    prunedByMoveRules = 0;
+    tableProbes = 0;
+    tableHits = 0;
+
+    iterationBounds.clear();
+    iterationNodes.clear();
+    iterationMillis.clear();
+
+    totalMillis = 0.0;
+    solutionLength = -1;
+}
+
+uint64_t SearchStats::totalNodes() const
+{
+    uint64_t total = 0;
+    for (int i = 0; i < MAX_DEPTH; i++)
+    {
+        total += nodesPerDepth[i];
+    }
+    return total;
+}
+
+double SearchStats::effectiveBranchingFactor() const
+{
+    size_t n = iterationNodes.size();
+    if (n < 2 || iterationNodes[n - 2] == 0)
+    {
+        return 0.0;
+    }
+
+    int boundStep = iterationBounds[n - 1] - iterationBounds[n - 2];
+    double ratio = static_cast<double>(iterationNodes[n - 1]) / static_cast<double>(iterationNodes[n - 2]);
+    return boundStep > 1 ? std::pow(ratio, 1.0 / boundStep) : ratio;
+}
+
+double SearchStats::nodesPerSecond() const
+{
+    if (totalMillis <= 0.0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(totalNodes()) * 1000.0 / totalMillis;
+}
+
+std::string SearchStats::toJson() const
+{
+    std::ostringstream out;
+    out << "{\"solution_length\":" << solutionLength;
+    out << ",\"nodes\":" << totalNodes();
+    out << ",\"nodes_per_depth\":";
+    writeCounterArray(out, nodesPerDepth, MAX_DEPTH);
+    out << ",\"effective_branching_factor\":" << effectiveBranchingFactor();
+    out << ",\"heuristic_histogram\":";
+    writeCounterArray(out, heuristicHistogram, MAX_HEURISTIC);
+    out << ",\"pruned_by_bound\":" << prunedByBound;
+    out << ",\"pruned_by_move_rules\":" << prunedByMoveRules;
+    out << ",\"table_probes\":" << tableProbes;
+    out << ",\"table_hits\":" << tableHits;
+    out << ",\"table_hit_rate\":" << (tableProbes ? static_cast<double>(tableHits) / tableProbes : 0.0);
+    out << ",\"iteration_bounds\":";
+    writeVector(out, iterationBounds);
+    out << ",\"iteration_nodes\":";
+    writeVector(out, iterationNodes);
+    out << ",\"iteration_ms\":";
+    writeVector(out, iterationMillis);
+    out << ",\"total_ms\":" << totalMillis;
+    out << ",\"nodes_per_sec\":" << nodesPerSecond();
+    out << "}";
+    return out.str();
+}
@@ -0,0 +1,136 @@
+#include "SolutionCache.h"
+
+SolutionCache::SolutionCache(size_t capacity, size_t shardCount)
+{
+    if (shardCount == 0)
+        shardCount = 1;
+    for (size_t i = 0; i < shardCount; i++)
+    {
+        shards.emplace_back(new Shard);
+        // Spread the remainder so the shards add up to the full capacity.
+        shards.back()->capacity = capacity / shardCount + (i < capacity % shardCount ? 1 : 0);
+    }
+}
+
+static bool solves(const CubieCube &cube, const std::vector<Move> &solution)
+{
+    CubieCube check = cube;
+    check.apply(solution.data(), solution.size());
+    return check.isSolved();
+}
+
+SolutionCache::Shard &SolutionCache::shardFor(const PackedState &key)
+{
+    // The high bits, since the low ones pick the bucket inside the shard.
+    return *shards[(PackedStateHash()(key) >> 40) % shards.size()];
+}
+
+bool SolutionCache::lookup(const CubieCube &cube, std::vector<Move> &solution)
+{
+    int symmetry;
+    PackedState key = canonicalState(cube, symmetry);
+    return lookupCanonical(key, symmetry, solution);
+}
+
+void SolutionCache::insert(const CubieCube &cube, const std::vector<Move> &solution)
+{
+    if (!solves(cube, solution))
+        return;
+    int symmetry;
+    PackedState key = canonicalState(cube, symmetry);
+    insertCanonical(key, symmetry, solution);
+}
+
+bool SolutionCache::lookupCanonical(const PackedState &key, int symmetry, std::vector<Move> &solution)
+{
+    Shard &shard = shardFor(key);
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end())
+        {
+            shard.misses++;
+            return false;
+        }
+        shard.hits++;
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        solution = found->second->second;
+    }
+
+    // The stored solution solves the canonical state; map it back.
+    int back = inverseSymmetry(symmetry);
+    for (Move &m : solution)
+        m = symmetryMove(back, m);
+    return true;
+}
+
+void SolutionCache::insertCanonical(const PackedState &key, int symmetry, const std::vector<Move> &solution)
+{
+    std::vector<Move> canonical(solution);
+    for (Move &m : canonical)
+        m = symmetryMove(symmetry, m);
+
+    Shard &shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.capacity == 0)
+        return;
+
+    auto found = shard.index.find(key);
+    if (found != shard.index.end())
+    {
+        // Keep the shorter of the two solutions.
+        if (canonical.size() < found->second->second.size())
+            found->second->second.swap(canonical);
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+
+    if (shard.entries.size() >= shard.capacity)
+    {
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+        shard.evictions++;
+    }
+    shard.entries.emplace_front(key, std::move(canonical));
+    shard.index[key] = shard.entries.begin();
+    shard.insertions++;
+}
+
+std::vector<Move> SolutionCache::solve(const CubieCube &cube, const std::function<std::vector<Move>(const CubieCube &)> &solver)
+{
+    int symmetry;
+    PackedState key = canonicalState(cube, symmetry);
+    std::vector<Move> solution;
+    if (lookupCanonical(key, symmetry, solution))
+        return solution;
+    solution = solver(cube);
+    if (solves(cube, solution))
+        insertCanonical(key, symmetry, solution);
+    return solution;
+}
+
+CacheStats SolutionCache::stats() const
+{
+    CacheStats total = {0, 0, 0, 0, 0};
+    for (const std::unique_ptr<Shard> &shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total.hits += shard->hits;
+        total.misses += shard->misses;
+        total.insertions += shard->insertions;
+        total.evictions += shard->evictions;
+        total.size += shard->entries.size();
+    }
+    return total;
+}
+
+void SolutionCache::clear()
+{
+    for (std::unique_ptr<Shard> &shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->entries.clear();
+        shard->index.clear();
+    }
+}
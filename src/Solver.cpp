@@ -0,0 +1,259 @@
+#include "Solver.h"
+#include "Facelets.h"
+#include "IDAstarSolver.h"
+#include "Symmetry.h"
+#include "ThistlethwaiteSolver.h"
+#include "TwoPhaseSolver.h"
+
+// Below these bounds IDA* is about as quick as a table walk (FASTEST) or
+// well under a millisecond (BOUNDED); see the note at EXACT_DEPTH_CAP. All
+// of this assumes the pattern databases: on the piece count alone even a
+// depth-5 search takes hundreds of milliseconds, so without them only
+// OPTIMAL requests run IDA*.
+static constexpr int FASTEST_EXACT_BOUND = 5;
+static constexpr int BOUNDED_EXACT_BOUND = 7;
+// Deepest IDA* search a BOUNDED request will start when it is not asked for
+// optimality: with the three pattern databases an exhaustive search to depth
+// 11 takes tens of milliseconds, depth 12 already a few hundred.
+static constexpr int EXACT_DEPTH_CAP = 11;
+
+static const char *const ENGINE_NAMES[NUM_SOLVER_ENGINES] = {"none", "IDA*", "Thistlethwaite", "two-phase", "cache"};
+
+static const char *const DATABASE_FILES[NUM_PATTERN_KINDS] = {"corners.pdb", "edges-first.pdb", "edges-last.pdb"};
+
+const char *solverEngineName(SolverEngine engine)
+{
+    return ENGINE_NAMES[static_cast<int>(engine)];
+}
+
+// A move turns 4 corners and 4 edges, so at least a quarter of the pieces
+// out of place, rounded up, of each kind remain to be moved.
+static int misplacedPieceBound(const CubieCube &cube)
+{
+    int corners = 0, edges = 0;
+    for (int i = 0; i < 8; i++)
+        corners += cube.cp[i] != i || cube.co[i] != 0;
+    for (int i = 0; i < 12; i++)
+        edges += cube.ep[i] != i || cube.eo[i] != 0;
+    return (std::max(corners, edges) + 3) / 4;
+}
+
+// The pattern databases where loaded, the piece count where not.
+struct SolverHeuristic
+{
+    PatternDatabaseHeuristic databases;
+
+    int operator()(const CubieCube &cube, SearchStats &stats) const
+    {
+        return std::max(databases(cube, stats), misplacedPieceBound(cube));
+    }
+
+    int operator()(const CubieCube &cube, int depth, SearchStats &stats)
+    {
+        return std::max(databases(cube, depth, stats), misplacedPieceBound(cube));
+    }
+};
+
+static std::string joinPath(const std::string &directory, const char *file)
+{
+    return directory.empty() || directory.back() == '/' ? directory + file : directory + "/" + file;
+}
+
+Solver::Solver()
+{
+}
+
+int Solver::loadPatternDatabases(const std::string &directory)
+{
+    int loaded = 0;
+    for (int k = 0; k < NUM_PATTERN_KINDS; k++)
+    {
+        PatternDatabase &database = databases[k];
+        if (database.load(joinPath(directory, DATABASE_FILES[k])) && database.kind() == static_cast<PatternKind>(k))
+            loaded++;
+        else
+            database = PatternDatabase();
+    }
+    return loaded;
+}
+
+void Solver::buildPatternDatabases(const std::string &directory)
+{
+    for (int k = 0; k < NUM_PATTERN_KINDS; k++)
+    {
+        if (databases[k].isLoaded())
+            continue;
+        databases[k].build(static_cast<PatternKind>(k));
+        if (!directory.empty())
+            databases[k].save(joinPath(directory, DATABASE_FILES[k]));
+    }
+}
+
+bool Solver::databasesLoaded() const
+{
+    for (const PatternDatabase &database : databases)
+    {
+        if (!database.isLoaded())
+            return false;
+    }
+    return true;
+}
+
+int Solver::lowerBound(const CubieCube &cube) const
+{
+    SolverHeuristic heuristic;
+    for (int k = 0; k < NUM_PATTERN_KINDS; k++)
+        heuristic.databases.databases[k] = &databases[k];
+    SearchStats stats;
+    return heuristic(cube, stats);
+}
+
+bool Solver::solveExact(const CubieCube &cube, int maxDepth, std::vector<Move> &solution)
+{
+    SolverHeuristic heuristic;
+    for (int k = 0; k < NUM_PATTERN_KINDS; k++)
+        heuristic.databases.databases[k] = &databases[k];
+    IDAstarSolver<CubieCube, SolverHeuristic> search(cube, heuristic);
+    solution = search.solve(maxDepth);
+    return !solution.empty();
+}
+
+void Solver::record(SolverEngine engine, std::chrono::steady_clock::time_point start)
+{
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && micros >= static_cast<double>(uint64_t(1) << bucket))
+        bucket++;
+    AtomicEngineStats &stats = engineStats[static_cast<int>(engine)];
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.latency[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+SolveResponse Solver::solve(const CubieCube &cube, const SolveRequest &request)
+{
+    auto requestStart = std::chrono::steady_clock::now();
+    SolveResponse response;
+    bool cached = cache && request.policy != SolvePolicy::FASTEST;
+    PackedState key = {0, 0};
+    int symmetry = 0;
+
+    auto finish = [&](SolverEngine engine, bool solved, bool optimal) {
+        response.engine = engine;
+        response.solved = solved;
+        response.optimal = solved && optimal;
+        if (!solved)
+            response.solution.clear();
+        else if (cached && (engine == SolverEngine::IDA_STAR || engine == SolverEngine::TWO_PHASE))
+            cache->insertCanonical(key, symmetry, response.solution);
+        engineStats[static_cast<int>(engine)].routed.fetch_add(1, std::memory_order_relaxed);
+        response.micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - requestStart).count();
+        return response;
+    };
+    auto exact = [&](int maxDepth) {
+        auto start = std::chrono::steady_clock::now();
+        bool found = solveExact(cube, maxDepth, response.solution);
+        record(SolverEngine::IDA_STAR, start);
+        return found;
+    };
+    auto thistlethwaite = [&] {
+        auto start = std::chrono::steady_clock::now();
+        ThistlethwaiteResult result = ThistlethwaiteSolver().solve(cube);
+        record(SolverEngine::THISTLETHWAITE, start);
+        response.solution = result.solution;
+        return result.solved;
+    };
+
+    // No engine can solve a state that turning faces cannot reach, and the
+    // probe would index the tables with its unchecked pieces.
+    if (validateCubie(cube) != FaceletError::NONE)
+        return finish(SolverEngine::NONE, false, false);
+    response.lowerBound = lowerBound(cube);
+    if (response.lowerBound == 0 && cube.isSolved())
+        return finish(SolverEngine::NONE, true, true);
+
+    if (cached)
+    {
+        auto start = std::chrono::steady_clock::now();
+        key = canonicalState(cube, symmetry);
+        bool hit = cache->lookupCanonical(key, symmetry, response.solution);
+        record(SolverEngine::CACHE, start);
+        int length = static_cast<int>(response.solution.size());
+        bool shortest = length == response.lowerBound;
+        if (hit && (request.policy == SolvePolicy::OPTIMAL ? shortest : length <= request.maxLength))
+            return finish(SolverEngine::CACHE, true, shortest);
+    }
+    bool exactIsQuick = databasesLoaded();
+
+    switch (request.policy)
+    {
+    case SolvePolicy::OPTIMAL:
+        return finish(SolverEngine::IDA_STAR, exact(MoveStack<CubieCube>::CAPACITY), true);
+
+    case SolvePolicy::FASTEST:
+        if (exactIsQuick && response.lowerBound <= FASTEST_EXACT_BOUND && exact(FASTEST_EXACT_BOUND + 2))
+            return finish(SolverEngine::IDA_STAR, true, true);
+        return finish(SolverEngine::THISTLETHWAITE, thistlethwaite(), false);
+
+    case SolvePolicy::BOUNDED:
+        break;
+    }
+
+    if (response.lowerBound > request.maxLength)
+        return finish(SolverEngine::NONE, false, false);
+    if (exactIsQuick && response.lowerBound <= BOUNDED_EXACT_BOUND)
+    {
+        // Exhausting every depth up to maxLength also proves there is no
+        // solution, so a miss only falls through when the cap cut it short.
+        bool found = exact(std::min(request.maxLength, EXACT_DEPTH_CAP));
+        if (found || request.maxLength <= EXACT_DEPTH_CAP)
+            return finish(SolverEngine::IDA_STAR, found, true);
+    }
+    if (thistlethwaite() && static_cast<int>(response.solution.size()) <= request.maxLength)
+        return finish(SolverEngine::THISTLETHWAITE, true, false);
+
+    auto start = std::chrono::steady_clock::now();
+    TwoPhaseOptions options;
+    options.maxLength = request.maxLength;
+    options.targetLength = request.maxLength;
+    options.deadline = start + request.timeLimit;
+    TwoPhaseResult result = TwoPhaseSolver().solve(cube, options);
+    record(SolverEngine::TWO_PHASE, start);
+    response.solution = result.solution;
+    return finish(SolverEngine::TWO_PHASE, result.found, false);
+}
+
+void Solver::enableCache(size_t capacity)
+{
+    cache.reset(capacity > 0 ? new SolutionCache(capacity) : nullptr);
+}
+
+CacheStats Solver::cacheStats() const
+{
+    return cache ? cache->stats() : CacheStats{0, 0, 0, 0, 0};
+}
+
+SolverStats Solver::stats() const
+{
+    SolverStats snapshot;
+    for (int e = 0; e < NUM_SOLVER_ENGINES; e++)
+    {
+        const AtomicEngineStats &from = engineStats[e];
+        EngineStats &to = snapshot.engines[e];
+        to.routed = from.routed.load(std::memory_order_relaxed);
+        to.calls = from.calls.load(std::memory_order_relaxed);
+        for (int b = 0; b < LATENCY_BUCKETS; b++)
+            to.latency[b] = from.latency[b].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void Solver::resetStats()
+{
+    for (AtomicEngineStats &stats : engineStats)
+    {
+        stats.routed = 0;
+        stats.calls = 0;
+        for (std::atomic<uint64_t> &count : stats.latency)
+            count = 0;
+    }
+}
@@ -0,0 +1,223 @@
+#include "StateFile.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char STATE_FILE_MAGIC[8] = {'R', 'U', 'B', 'I', 'K', 'S', 'S', 'T'};
+
+// The writer grows its file by at least this much at a time.
+static const size_t WRITER_GROW_BYTES = 1 << 20;
+
+static size_t idOffset()
+{
+    return sizeof(PackedState);
+}
+
+static size_t solutionOffset(uint32_t flags)
+{
+    return sizeof(PackedState) + (flags & STATE_FILE_IDS ? sizeof(uint64_t) : 0);
+}
+
+size_t stateRecordSize(uint32_t flags)
+{
+    return solutionOffset(flags) + (flags & STATE_FILE_SOLUTIONS ? 1 + STATE_FILE_MAX_SOLUTION : 0);
+}
+
+// --- StateRecordView ---
+
+uint64_t StateRecordView::id() const
+{
+    if (!hasId())
+        return 0;
+    uint64_t value;
+    std::memcpy(&value, record + idOffset(), sizeof(value));
+    return value;
+}
+
+bool StateRecordView::hasSolution() const
+{
+    return (flags & STATE_FILE_SOLUTIONS) && record[solutionOffset(flags)] != STATE_FILE_NO_SOLUTION;
+}
+
+size_t StateRecordView::solutionLength() const
+{
+    return hasSolution() ? record[solutionOffset(flags)] : 0;
+}
+
+const Move *StateRecordView::solution() const
+{
+    if (!(flags & STATE_FILE_SOLUTIONS))
+        return nullptr;
+    return reinterpret_cast<const Move *>(record + solutionOffset(flags) + 1);
+}
+
+// --- StateFileReader ---
+
+StateFileReader::~StateFileReader()
+{
+    close();
+}
+
+bool StateFileReader::open(const std::string &path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(StateFileHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(info.st_size);
+    void *mapped = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    const StateFileHeader *header = static_cast<const StateFileHeader *>(mapped);
+    bool valid = std::memcmp(header->magic, STATE_FILE_MAGIC, sizeof(STATE_FILE_MAGIC)) == 0 &&
+                 header->version == STATE_FILE_VERSION &&
+                 (header->flags & ~(STATE_FILE_IDS | STATE_FILE_SOLUTIONS)) == 0 &&
+                 header->recordSize == stateRecordSize(header->flags) &&
+                 header->recordCount <= (bytes - sizeof(StateFileHeader)) / header->recordSize;
+    if (!valid)
+    {
+        munmap(mapped, bytes);
+        return false;
+    }
+
+    // Records are normally read front to back.
+    madvise(mapped, bytes, MADV_SEQUENTIAL);
+
+    base = mapped;
+    mappedBytes = bytes;
+    records = static_cast<const uint8_t *>(mapped) + sizeof(StateFileHeader);
+    recordSize = header->recordSize;
+    count = static_cast<size_t>(header->recordCount);
+    fileFlags = header->flags;
+    return true;
+}
+
+void StateFileReader::close()
+{
+    if (base != nullptr)
+        munmap(base, mappedBytes);
+    base = nullptr;
+    mappedBytes = 0;
+    records = nullptr;
+    recordSize = 0;
+    count = 0;
+    fileFlags = 0;
+}
+
+// --- StateFileWriter ---
+
+StateFileWriter::~StateFileWriter()
+{
+    close();
+}
+
+bool StateFileWriter::create(const std::string &path, uint32_t flags)
+{
+    close();
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+
+    fileFlags = flags & (STATE_FILE_IDS | STATE_FILE_SOLUTIONS);
+    recordSize = stateRecordSize(fileFlags);
+    count = 0;
+    failed = false;
+    return reserve(0);
+}
+
+// Makes room for `records` records, growing and remapping the file if needed.
+bool StateFileWriter::reserve(size_t records)
+{
+    size_t needed = sizeof(StateFileHeader) + records * recordSize;
+    if (base != nullptr && needed <= mappedBytes)
+        return true;
+
+    size_t bytes = mappedBytes == 0 ? WRITER_GROW_BYTES : mappedBytes * 2;
+    while (bytes < needed)
+        bytes *= 2;
+
+    if (base != nullptr)
+        munmap(base, mappedBytes);
+    base = nullptr;
+    mappedBytes = 0;
+
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        failed = true;
+        return false;
+    }
+    void *mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        failed = true;
+        return false;
+    }
+    base = static_cast<uint8_t *>(mapped);
+    mappedBytes = bytes;
+    return true;
+}
+
+bool StateFileWriter::append(const PackedState &state, uint64_t id, const Move *solution, size_t solutionLength)
+{
+    if (fd < 0 || failed || solutionLength > STATE_FILE_MAX_SOLUTION || !reserve(count + 1))
+        return false;
+
+    uint8_t *record = base + sizeof(StateFileHeader) + count * recordSize;
+    std::memcpy(record, &state, sizeof(state));
+    if (fileFlags & STATE_FILE_IDS)
+        std::memcpy(record + idOffset(), &id, sizeof(id));
+    if (fileFlags & STATE_FILE_SOLUTIONS)
+    {
+        uint8_t *slot = record + solutionOffset(fileFlags);
+        std::memset(slot, 0, 1 + STATE_FILE_MAX_SOLUTION);
+        slot[0] = solution != nullptr ? static_cast<uint8_t>(solutionLength) : STATE_FILE_NO_SOLUTION;
+        if (solution != nullptr)
+            std::memcpy(slot + 1, solution, solutionLength * sizeof(Move));
+    }
+    count++;
+    return true;
+}
+
+bool StateFileWriter::close()
+{
+    if (fd < 0)
+        return true;
+
+    bool ok = !failed && base != nullptr;
+    if (ok)
+    {
+        StateFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, STATE_FILE_MAGIC, sizeof(STATE_FILE_MAGIC));
+        header.version = STATE_FILE_VERSION;
+        header.flags = fileFlags;
+        header.recordSize = static_cast<uint32_t>(recordSize);
+        header.recordCount = count;
+        std::memcpy(base, &header, sizeof(header));
+    }
+    if (base != nullptr)
+        munmap(base, mappedBytes);
+    if (ok)
+        ok = ftruncate(fd, static_cast<off_t>(sizeof(StateFileHeader) + count * recordSize)) == 0;
+    ok = ::close(fd) == 0 && ok;
+
+    fd = -1;
+    base = nullptr;
+    mappedBytes = 0;
+    count = 0;
+    return ok;
+}
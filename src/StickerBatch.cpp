@@ -0,0 +1,96 @@
+#include "StickerBatch.h"
+#include <algorithm>
+
+// Pads a 54-entry transform to the 64-byte row (padding maps to itself) and
+// prepares it for the active kernel.
+static void prepareControl(const CubeTransform &transform, uint8_t *control)
+{
+    uint8_t source[KERNEL_ROW_BYTES];
+    for (size_t i = 0; i < KERNEL_ROW_BYTES; i++)
+    {
+        source[i] = i < static_cast<size_t>(RubiksCube::NUM_STICKERS) ? transform.data()[i] : static_cast<uint8_t>(i);
+    }
+    activeKernels().preparePermute(source, control);
+}
+
+// The solved row: every sticker has the color of its face.
+static const uint8_t *solvedRow()
+{
+    static const struct SolvedRow
+    {
+        uint8_t bytes[KERNEL_ROW_BYTES];
+        SolvedRow()
+        {
+            for (size_t i = 0; i < KERNEL_ROW_BYTES; i++)
+                bytes[i] = i < static_cast<size_t>(RubiksCube::NUM_STICKERS) ? static_cast<uint8_t>(i / 9) : 0;
+        }
+    } solved;
+    return solved.bytes;
+}
+
+StickerBatch::StickerBatch(size_t count) : rows(count * KERNEL_ROW_BYTES), count(count)
+{
+    for (size_t n = 0; n < count; n++)
+    {
+        std::copy(solvedRow(), solvedRow() + KERNEL_ROW_BYTES, row(n));
+    }
+}
+
+void StickerBatch::load(size_t index, const RubiksCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    cube.getStickers(stickers);
+    uint8_t *dst = row(index);
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        dst[i] = static_cast<uint8_t>(stickers[i]);
+    }
+}
+
+void StickerBatch::store(size_t index, RubiksCube &cube) const
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS];
+    const uint8_t *src = row(index);
+    for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+    {
+        stickers[i] = static_cast<RubiksCube::Color>(src[i]);
+    }
+    cube.setStickers(stickers);
+}
+
+void StickerBatch::apply(const CubeTransform &transform)
+{
+    alignas(64) uint8_t control[KERNEL_CONTROL_BYTES];
+    prepareControl(transform, control);
+    activeKernels().permuteRows(control, rows.data(), count);
+}
+
+const uint8_t *StickerBatch::moveControls()
+{
+    // Prepared once.
+    static const struct MoveControls
+    {
+        alignas(64) uint8_t control[NUM_MOVES][KERNEL_CONTROL_BYTES];
+        MoveControls()
+        {
+            for (int i = 0; i < NUM_MOVES; i++)
+                prepareControl(CubeTransform::fromMove(static_cast<Move>(i)), control[i]);
+        }
+    } moves;
+    return moves.control[0];
+}
+
+void StickerBatch::apply(Move m)
+{
+    activeKernels().permuteRows(moveControls() + static_cast<size_t>(m) * KERNEL_CONTROL_BYTES, rows.data(), count);
+}
+
+void StickerBatch::apply(const Move *moves, size_t length)
+{
+    apply(CubeTransform::fromMoves(moves, length));
+}
+
+size_t StickerBatch::countSolved() const
+{
+    return activeKernels().countEqualRows(rows.data(), count, solvedRow());
+}
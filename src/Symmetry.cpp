@@ -0,0 +1,176 @@
+#include "Symmetry.h"
+#include <cstring>
+
+// A sticker as a point on the surface: the cubie's position (each coordinate
+// -1, 0 or 1, x to the right, y up, z to the front) and the face normal.
+struct StickerPlace
+{
+    int pos[3];
+    int normal[3];
+};
+
+static StickerPlace placeOf(int sticker)
+{
+    int face = sticker / 9, row = sticker % 9 / 3, col = sticker % 3;
+    StickerPlace p = {{0, 0, 0}, {0, 0, 0}};
+    switch (face)
+    {
+    case 0: // U: row 0 at the back
+        p = {{col - 1, 1, row - 1}, {0, 1, 0}};
+        break;
+    case 1: // L: column 0 at the back
+        p = {{-1, 1 - row, col - 1}, {-1, 0, 0}};
+        break;
+    case 2: // F
+        p = {{col - 1, 1 - row, 1}, {0, 0, 1}};
+        break;
+    case 3: // R: column 0 at the front
+        p = {{1, 1 - row, 1 - col}, {1, 0, 0}};
+        break;
+    case 4: // B: column 0 at the right
+        p = {{1 - col, 1 - row, -1}, {0, 0, -1}};
+        break;
+    case 5: // D: row 0 at the front
+        p = {{col - 1, -1, 1 - row}, {0, -1, 0}};
+        break;
+    }
+    return p;
+}
+
+struct SymmetryTables
+{
+    // destination[s][i]: where symmetry s takes sticker i.
+    uint8_t destination[NUM_SYMMETRIES][RubiksCube::NUM_STICKERS];
+    // recolor[s][c]: the color that c becomes.
+    RubiksCube::Color recolor[NUM_SYMMETRIES][6];
+    Move moves[NUM_SYMMETRIES][NUM_MOVES];
+    int inverse[NUM_SYMMETRIES];
+
+    void conjugate(int s, const RubiksCube::Color *in, RubiksCube::Color *out) const
+    {
+        for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+            out[destination[s][i]] = recolor[s][static_cast<int>(in[i])];
+    }
+
+    SymmetryTables()
+    {
+        StickerPlace places[RubiksCube::NUM_STICKERS];
+        for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+            places[i] = placeOf(i);
+
+        // Every signed permutation matrix, the identity first.
+        static const int axisOrders[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+        int s = 0;
+        for (const int *axes : axisOrders)
+        {
+            for (int signs = 0; signs < 8; signs++, s++)
+            {
+                for (int i = 0; i < RubiksCube::NUM_STICKERS; i++)
+                {
+                    StickerPlace mapped;
+                    for (int k = 0; k < 3; k++)
+                    {
+                        int sign = signs >> k & 1 ? -1 : 1;
+                        mapped.pos[k] = sign * places[i].pos[axes[k]];
+                        mapped.normal[k] = sign * places[i].normal[axes[k]];
+                    }
+                    for (int j = 0; j < RubiksCube::NUM_STICKERS; j++)
+                    {
+                        bool same = true;
+                        for (int k = 0; k < 3; k++)
+                            same = same && places[j].pos[k] == mapped.pos[k] && places[j].normal[k] == mapped.normal[k];
+                        if (same)
+                            destination[s][i] = static_cast<uint8_t>(j);
+                    }
+                }
+                for (int face = 0; face < 6; face++)
+                    recolor[s][face] = static_cast<RubiksCube::Color>(destination[s][face * 9 + 4] / 9);
+            }
+        }
+
+        // Each move applied to the solved cube, to recognise conjugated moves.
+        RubiksCube::Color candidates[NUM_MOVES][RubiksCube::NUM_STICKERS];
+        for (int m = 0; m < NUM_MOVES; m++)
+        {
+            CubieCube moved;
+            moved.move(static_cast<Move>(m));
+            moved.toStickers(candidates[m]);
+        }
+
+        for (s = 0; s < NUM_SYMMETRIES; s++)
+        {
+            for (int t = 0; t < NUM_SYMMETRIES; t++)
+            {
+                bool identity = true;
+                for (int i = 0; i < RubiksCube::NUM_STICKERS && identity; i++)
+                    identity = destination[t][destination[s][i]] == i;
+                if (identity)
+                    inverse[s] = t;
+            }
+
+            RubiksCube::Color mapped[RubiksCube::NUM_STICKERS];
+            for (int m = 0; m < NUM_MOVES; m++)
+            {
+                conjugate(s, candidates[m], mapped);
+                for (int candidate = 0; candidate < NUM_MOVES; candidate++)
+                {
+                    if (std::memcmp(candidates[candidate], mapped, sizeof(mapped)) == 0)
+                        moves[s][m] = static_cast<Move>(candidate);
+                }
+            }
+        }
+    }
+};
+
+static const SymmetryTables &tables()
+{
+    static const SymmetryTables shared;
+    return shared;
+}
+
+void applySymmetry(int symmetry, const RubiksCube::Color *in, RubiksCube::Color *out)
+{
+    tables().conjugate(symmetry, in, out);
+}
+
+CubieCube applySymmetry(int symmetry, const CubieCube &cube)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS], mapped[RubiksCube::NUM_STICKERS];
+    cube.toStickers(stickers);
+    applySymmetry(symmetry, stickers, mapped);
+    CubieCube result;
+    result.fromStickers(mapped);
+    return result;
+}
+
+Move symmetryMove(int symmetry, Move m)
+{
+    return tables().moves[symmetry][static_cast<int>(m)];
+}
+
+int inverseSymmetry(int symmetry)
+{
+    return tables().inverse[symmetry];
+}
+
+PackedState canonicalState(const CubieCube &cube, int &symmetry)
+{
+    RubiksCube::Color stickers[RubiksCube::NUM_STICKERS], mapped[RubiksCube::NUM_STICKERS];
+    cube.toStickers(stickers);
+
+    PackedState best = packState(cube);
+    symmetry = 0;
+    for (int s = 1; s < NUM_SYMMETRIES; s++)
+    {
+        applySymmetry(s, stickers, mapped);
+        CubieCube conjugate;
+        conjugate.fromStickers(mapped);
+        PackedState packed = packState(conjugate);
+        if (packed < best)
+        {
+            best = packed;
+            symmetry = s;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,217 @@
+#include "TableMemory.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+const char *pageKindName(PageKind kind)
+{
+    switch (kind)
+    {
+    case PageKind::NONE:
+        return "none";
+    case PageKind::NORMAL:
+        return "4 KB pages";
+    case PageKind::TRANSPARENT_HUGE:
+        return "transparent 2 MB pages";
+    case PageKind::EXPLICIT_HUGE:
+        return "explicit 2 MB pages";
+    }
+    return "unknown";
+}
+
+static size_t roundUp(size_t bytes, size_t unit)
+{
+    return (bytes + unit - 1) / unit * unit;
+}
+
+TableMemory::~TableMemory()
+{
+    release();
+}
+
+TableMemory::TableMemory(TableMemory &&other)
+{
+    *this = std::move(other);
+}
+
+TableMemory &TableMemory::operator=(TableMemory &&other)
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(base, other.base);
+        std::swap(bytes, other.bytes);
+        std::swap(mappedBytes, other.mappedBytes);
+        std::swap(kind, other.kind);
+    }
+    return *this;
+}
+
+void TableMemory::release()
+{
+    if (base)
+        munmap(base, mappedBytes);
+    base = nullptr;
+    bytes = 0;
+    mappedBytes = 0;
+    kind = PageKind::NONE;
+}
+
+bool TableMemory::allocate(size_t size, PagePolicy policy)
+{
+    release();
+    size_t rounded = roundUp(size > 0 ? size : 1, HUGE_PAGE_SIZE);
+
+#ifdef MAP_HUGETLB
+    if (policy == PagePolicy::HUGE_IF_AVAILABLE)
+    {
+        void *mapped = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapped != MAP_FAILED)
+        {
+            base = static_cast<uint8_t *>(mapped);
+            bytes = size;
+            mappedBytes = rounded;
+            kind = PageKind::EXPLICIT_HUGE;
+            return true;
+        }
+    }
+#endif
+
+    // Transparent huge pages only cover 2 MB aligned ranges, so map one huge
+    // page more than needed and trim the ends to an aligned window.
+    size_t padded = rounded + (policy == PagePolicy::HUGE_IF_AVAILABLE ? HUGE_PAGE_SIZE : 0);
+    void *mapped = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED)
+        return false;
+    uint8_t *start = static_cast<uint8_t *>(mapped);
+    kind = PageKind::NORMAL;
+    if (policy == PagePolicy::HUGE_IF_AVAILABLE)
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(start);
+        uint8_t *aligned = reinterpret_cast<uint8_t *>(roundUp(address, HUGE_PAGE_SIZE));
+        if (aligned > start)
+            munmap(start, aligned - start);
+        size_t tail = (start + padded) - (aligned + rounded);
+        if (tail > 0)
+            munmap(aligned + rounded, tail);
+        start = aligned;
+#ifdef MADV_HUGEPAGE
+        if (madvise(start, rounded, MADV_HUGEPAGE) == 0)
+            kind = PageKind::TRANSPARENT_HUGE;
+#endif
+    }
+#ifdef MADV_NOHUGEPAGE
+    else
+    {
+        // Keeps 4 KB pages even where THP is on for every mapping.
+        madvise(start, rounded, MADV_NOHUGEPAGE);
+    }
+#endif
+    base = start;
+    bytes = size;
+    mappedBytes = rounded;
+    return true;
+}
+
+bool TableMemory::mapFile(const std::string &path, PagePolicy policy)
+{
+    release();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+
+    void *mapped = MAP_FAILED;
+    kind = PageKind::NORMAL;
+#ifdef MAP_HUGETLB
+    // Only succeeds for files on hugetlbfs; anywhere else mmap refuses the flag.
+    if (policy == PagePolicy::HUGE_IF_AVAILABLE)
+    {
+        mapped = mmap(nullptr, roundUp(size, HUGE_PAGE_SIZE), PROT_READ, MAP_SHARED | MAP_HUGETLB, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            kind = PageKind::EXPLICIT_HUGE;
+            mappedBytes = roundUp(size, HUGE_PAGE_SIZE);
+        }
+    }
+#endif
+    if (mapped == MAP_FAILED)
+    {
+        mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        mappedBytes = size;
+#ifdef MADV_HUGEPAGE
+        if (mapped != MAP_FAILED && policy == PagePolicy::HUGE_IF_AVAILABLE && madvise(mapped, size, MADV_HUGEPAGE) == 0)
+            kind = PageKind::TRANSPARENT_HUGE;
+#endif
+    }
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        kind = PageKind::NONE;
+        mappedBytes = 0;
+        return false;
+    }
+    base = static_cast<uint8_t *>(mapped);
+    bytes = size;
+    return true;
+}
+
+bool TableMemory::loadFile(const std::string &path, PagePolicy policy)
+{
+    release();
+    std::FILE *in = std::fopen(path.c_str(), "rb");
+    if (!in)
+        return false;
+    bool ok = std::fseek(in, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(in) : -1;
+    ok = size > 0 && std::fseek(in, 0, SEEK_SET) == 0 && allocate(static_cast<size_t>(size), policy) &&
+         std::fread(base, 1, bytes, in) == bytes;
+    std::fclose(in);
+    if (!ok)
+        release();
+    return ok;
+}
+
+size_t TableMemory::hugeBytes() const
+{
+    if (!base)
+        return 0;
+    if (kind == PageKind::EXPLICIT_HUGE)
+        return mappedBytes;
+
+    // smaps lists each mapping as "start-end perms ..." followed by its
+    // counters; the ones of interest are AnonHugePages and FilePmdMapped.
+    std::FILE *smaps = std::fopen("/proc/self/smaps", "r");
+    if (!smaps)
+        return 0;
+    uintptr_t begin = reinterpret_cast<uintptr_t>(base);
+    uintptr_t end = begin + mappedBytes;
+    bool inside = false;
+    size_t total = 0;
+    char line[512];
+    while (std::fgets(line, sizeof(line), smaps))
+    {
+        unsigned long from, to;
+        char dash;
+        if (std::sscanf(line, "%lx%c%lx", &from, &dash, &to) == 3 && dash == '-')
+        {
+            inside = from < end && to > begin;
+            continue;
+        }
+        unsigned long kb;
+        if (inside && (std::sscanf(line, "AnonHugePages: %lu kB", &kb) == 1 || std::sscanf(line, "FilePmdMapped: %lu kB", &kb) == 1))
+            total += kb * 1024;
+    }
+    std::fclose(smaps);
+    return total;
+}
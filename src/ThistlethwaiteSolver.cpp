@@ -0,0 +1,523 @@
+#include "ThistlethwaiteSolver.h"
+#include "Coordinates.h"
+#include "Facelets.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+// The moves of G0, G1, G2 and G3, each phase turning only those of the group
+// it starts in.
+static const Move PHASE2_MOVES[] = {Move::U, Move::U_PRIME, Move::U2, Move::L, Move::L_PRIME, Move::L2, Move::R,
+                                    Move::R_PRIME, Move::R2, Move::D, Move::D_PRIME, Move::D2, Move::F2, Move::B2};
+static const Move PHASE3_MOVES[] = {Move::U, Move::U_PRIME, Move::U2, Move::D, Move::D_PRIME, Move::D2,
+                                    Move::L2, Move::F2, Move::R2, Move::B2};
+static const Move PHASE4_MOVES[] = {Move::U2, Move::L2, Move::F2, Move::R2, Move::B2, Move::D2};
+static const int NUM_PHASE2_MOVES = 14;
+static const int NUM_PHASE3_MOVES = 10;
+static const int NUM_PHASE4_MOVES = 6;
+
+// Corner permutations of G3, and the cosets of that group among all 8!.
+static const int NUM_HALF_TURN_CORNERS = 96;
+static const int NUM_CORNER_COSETS = 420;
+// Placements of the four M-slice edges among the eight U and D edge slots.
+static const int NUM_M_SLICE = 70;
+
+static const int PHASE2_STATES = NUM_TWIST * NUM_SLICE;
+static const int PHASE3_STATES = NUM_CORNER_COSETS * NUM_M_SLICE;
+// Corners, then the M, S and E slice permutations; the E permutation's
+// parity follows from the others, so only half its 24 values are indexed.
+static const int PHASE4_STATES = NUM_HALF_TURN_CORNERS * 24 * 24 * 12;
+
+// Edge slots of the three slices, as the phase-4 permutations number them.
+static const int SLICE_SLOTS[3][4] = {
+    {CubieCube::UF, CubieCube::UB, CubieCube::DF, CubieCube::DB}, // M
+    {CubieCube::UR, CubieCube::UL, CubieCube::DR, CubieCube::DL}, // S
+    {CubieCube::FR, CubieCube::FL, CubieCube::BL, CubieCube::BR}  // E
+};
+
+static const uint8_t UNSEEN = 0xFF;
+static const uint8_t NIBBLE_UNSEEN = 0xF;
+
+struct ThistlethwaiteSolver::Tables
+{
+    // Phase 1, by flip coordinate.
+    std::vector<uint8_t> flipDistance;
+    // Phase 2, by twist * NUM_SLICE + slice, two entries per byte.
+    std::vector<uint8_t> twistSliceDistance;
+
+    // The corner permutations of G3 as arrays, sorted by rank.
+    uint8_t halfTurnCorners[NUM_HALF_TURN_CORNERS][8];
+    uint16_t halfTurnCornerRank[NUM_HALF_TURN_CORNERS];
+    // Each coset's smallest rank, sorted; a coset's index is its position.
+    uint16_t cornerCosetRank[NUM_CORNER_COSETS];
+
+    // Phase 3, by coset * NUM_M_SLICE + M-slice placement.
+    uint16_t cornerCosetMove[NUM_CORNER_COSETS][NUM_PHASE3_MOVES];
+    uint8_t mSliceMove[NUM_M_SLICE][NUM_PHASE3_MOVES];
+    int phase3Goal;
+    std::vector<uint8_t> cosetDistance;
+
+    // Phase 4, two entries per byte.
+    uint8_t halfTurnCornerMove[NUM_HALF_TURN_CORNERS][NUM_PHASE4_MOVES];
+    uint8_t slicePermMove[3][24][NUM_PHASE4_MOVES];
+    uint8_t permParity[24];
+    std::vector<uint8_t> halfTurnDistance;
+
+    Tables();
+
+    int cornerCoset(const uint8_t *cp) const;
+    int halfTurnCornerIndex(const uint8_t *cp) const;
+    int phase4Index(int corners, int m, int s, int e) const;
+    void phase4Decode(int index, int *coords) const;
+};
+
+static int getNibble(const std::vector<uint8_t> &table, size_t index)
+{
+    return (table[index >> 1] >> ((index & 1) * 4)) & 0xF;
+}
+
+static void setNibble(std::vector<uint8_t> &table, size_t index, int value)
+{
+    int shift = (index & 1) * 4;
+    table[index >> 1] = static_cast<uint8_t>((table[index >> 1] & ~(0xF << shift)) | (value << shift));
+}
+
+// Breadth-first search from `goal` by levels; next(i, m) is the state move m
+// leads to. With 4-bit entries the search stops after `maxDepth` - 1 levels
+// and the states still unseen are taken to be at `maxDepth`.
+template <typename Next>
+static std::vector<uint8_t> buildNibbleTable(int states, int goal, int numMoves, int maxDepth, Next next)
+{
+    std::vector<uint8_t> table((states + 1) / 2, 0xFF);
+    setNibble(table, goal, 0);
+    bool grew = true;
+    for (int depth = 0; grew && depth < maxDepth - 1; depth++)
+    {
+        grew = false;
+        for (int i = 0; i < states; i++)
+        {
+            if (getNibble(table, i) != depth)
+                continue;
+            for (int m = 0; m < numMoves; m++)
+            {
+                int j = next(i, m);
+                if (getNibble(table, j) == NIBBLE_UNSEEN)
+                {
+                    setNibble(table, j, depth + 1);
+                    grew = true;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+template <typename Next>
+static std::vector<uint8_t> buildByteTable(int states, int goal, int numMoves, Next next)
+{
+    std::vector<uint8_t> table(states, UNSEEN);
+    std::vector<int> queue(1, goal);
+    table[goal] = 0;
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        int i = queue[head];
+        for (int m = 0; m < numMoves; m++)
+        {
+            int j = next(i, m);
+            if (table[j] == UNSEEN)
+            {
+                table[j] = static_cast<uint8_t>(table[i] + 1);
+                queue.push_back(j);
+            }
+        }
+    }
+    return table;
+}
+
+static void moveCorners(const uint8_t *cp, Move m, uint8_t *out)
+{
+    const CubieCube &move = CubieCube::moveCube(m);
+    for (int i = 0; i < 8; i++)
+        out[i] = cp[move.cp[i]];
+}
+
+// Which of the eight U and D edge slots hold M-slice edges, in the
+// combinatorial number system.
+static int mSliceCoord(const CubieCube &cube)
+{
+    int coord = 0, found = 0;
+    for (int slot = 0; slot < 8; slot++)
+    {
+        if (cube.ep[slot] == CubieCube::UF || cube.ep[slot] == CubieCube::UB || cube.ep[slot] == CubieCube::DF ||
+            cube.ep[slot] == CubieCube::DB)
+            coord += binomial(slot, ++found);
+    }
+    return coord;
+}
+
+// Permutation of one slice's edges, while they all are in that slice.
+static int slicePerm(const CubieCube &cube, int slice)
+{
+    uint8_t perm[4];
+    for (int i = 0; i < 4; i++)
+    {
+        int local = 0;
+        while (SLICE_SLOTS[slice][local] != cube.ep[SLICE_SLOTS[slice][i]])
+            local++;
+        perm[i] = static_cast<uint8_t>(local);
+    }
+    return permutationRank(perm, 4);
+}
+
+int ThistlethwaiteSolver::Tables::cornerCoset(const uint8_t *cp) const
+{
+    // G3 acts from the left: states g * x with g in G3 need the same phase-3
+    // moves as x, and (g * x).cp[i] = g.cp[x.cp[i]].
+    int smallest = NUM_CORNER_PERM;
+    for (int h = 0; h < NUM_HALF_TURN_CORNERS; h++)
+    {
+        uint8_t product[8];
+        for (int i = 0; i < 8; i++)
+            product[i] = halfTurnCorners[h][cp[i]];
+        smallest = std::min(smallest, permutationRank(product, 8));
+    }
+    const uint16_t *found = std::lower_bound(cornerCosetRank, cornerCosetRank + NUM_CORNER_COSETS, smallest);
+    return static_cast<int>(found - cornerCosetRank);
+}
+
+int ThistlethwaiteSolver::Tables::halfTurnCornerIndex(const uint8_t *cp) const
+{
+    int rank = permutationRank(cp, 8);
+    const uint16_t *found = std::lower_bound(halfTurnCornerRank, halfTurnCornerRank + NUM_HALF_TURN_CORNERS, rank);
+    if (found == halfTurnCornerRank + NUM_HALF_TURN_CORNERS || *found != rank)
+        return -1;
+    return static_cast<int>(found - halfTurnCornerRank);
+}
+
+int ThistlethwaiteSolver::Tables::phase4Index(int corners, int m, int s, int e) const
+{
+    return ((corners * 24 + m) * 24 + s) * 12 + e / 2;
+}
+
+// coords: corners, M, S and E permutations. Every G3 corner permutation is
+// even, so the edges are too, which fixes the low bit of the E rank.
+void ThistlethwaiteSolver::Tables::phase4Decode(int index, int *coords) const
+{
+    int half = index % 12;
+    index /= 12;
+    coords[2] = index % 24;
+    index /= 24;
+    coords[1] = index % 24;
+    coords[0] = index / 24;
+    int parity = permParity[coords[1]] ^ permParity[coords[2]];
+    coords[3] = half * 2 + (permParity[half * 2] != parity);
+}
+
+ThistlethwaiteSolver::Tables::Tables()
+{
+    RUBIKS_PROFILE_SCOPE("Thistlethwaite::tables");
+
+    // Phase 1: edge flips under all moves.
+    flipDistance = buildByteTable(NUM_FLIP, 0, NUM_MOVES, [](int flip, int m) {
+        CubieCube cube;
+        setFlipCoord(cube, flip);
+        cube.move(static_cast<Move>(m));
+        return flipCoord(cube);
+    });
+
+    // Phase 2: twists and E-slice placement through small move tables.
+    {
+        std::vector<uint16_t> twistMove(NUM_TWIST * NUM_PHASE2_MOVES), sliceMove(NUM_SLICE * NUM_PHASE2_MOVES);
+        for (int m = 0; m < NUM_PHASE2_MOVES; m++)
+        {
+            for (int twist = 0; twist < NUM_TWIST; twist++)
+            {
+                CubieCube cube;
+                setTwistCoord(cube, twist);
+                cube.move(PHASE2_MOVES[m]);
+                twistMove[twist * NUM_PHASE2_MOVES + m] = static_cast<uint16_t>(twistCoord(cube));
+            }
+            for (int slice = 0; slice < NUM_SLICE; slice++)
+            {
+                CubieCube cube;
+                setSliceCoord(cube, slice);
+                cube.move(PHASE2_MOVES[m]);
+                sliceMove[slice * NUM_PHASE2_MOVES + m] = static_cast<uint16_t>(sliceCoord(cube));
+            }
+        }
+        twistSliceDistance = buildNibbleTable(PHASE2_STATES, 0, NUM_PHASE2_MOVES, 15, [&](int i, int m) {
+            return twistMove[i / NUM_SLICE * NUM_PHASE2_MOVES + m] * NUM_SLICE + sliceMove[i % NUM_SLICE * NUM_PHASE2_MOVES + m];
+        });
+    }
+
+    // The corner permutations of G3: everything half turns reach from solved.
+    {
+        std::vector<bool> seen(NUM_CORNER_PERM, false);
+        std::vector<std::vector<uint8_t>> found(1, std::vector<uint8_t>(8));
+        for (int i = 0; i < 8; i++)
+            found[0][i] = static_cast<uint8_t>(i);
+        seen[0] = true;
+        for (size_t head = 0; head < found.size(); head++)
+        {
+            for (Move m : PHASE4_MOVES)
+            {
+                std::vector<uint8_t> next(8);
+                moveCorners(found[head].data(), m, next.data());
+                int rank = permutationRank(next.data(), 8);
+                if (!seen[rank])
+                {
+                    seen[rank] = true;
+                    found.push_back(next);
+                }
+            }
+        }
+        std::sort(found.begin(), found.end(), [](const std::vector<uint8_t> &a, const std::vector<uint8_t> &b) {
+            return permutationRank(a.data(), 8) < permutationRank(b.data(), 8);
+        });
+        for (int h = 0; h < NUM_HALF_TURN_CORNERS; h++)
+        {
+            std::copy(found[h].begin(), found[h].end(), halfTurnCorners[h]);
+            halfTurnCornerRank[h] = static_cast<uint16_t>(permutationRank(halfTurnCorners[h], 8));
+        }
+    }
+
+    // Phase 3: the cosets, each named by its smallest member, and the
+    // M-slice placements.
+    {
+        std::vector<bool> covered(NUM_CORNER_PERM, false);
+        int count = 0;
+        for (int rank = 0; rank < NUM_CORNER_PERM; rank++)
+        {
+            if (covered[rank])
+                continue;
+            // Ranks are visited in order, so the first uncovered one is the
+            // smallest of its coset.
+            uint8_t cp[8];
+            permutationUnrank(rank, cp, 8);
+            for (int h = 0; h < NUM_HALF_TURN_CORNERS; h++)
+            {
+                uint8_t product[8];
+                for (int i = 0; i < 8; i++)
+                    product[i] = halfTurnCorners[h][cp[i]];
+                covered[permutationRank(product, 8)] = true;
+            }
+            cornerCosetRank[count++] = static_cast<uint16_t>(rank);
+        }
+
+        for (int c = 0; c < NUM_CORNER_COSETS; c++)
+        {
+            uint8_t cp[8], moved[8];
+            permutationUnrank(cornerCosetRank[c], cp, 8);
+            for (int m = 0; m < NUM_PHASE3_MOVES; m++)
+            {
+                moveCorners(cp, PHASE3_MOVES[m], moved);
+                cornerCosetMove[c][m] = static_cast<uint16_t>(cornerCoset(moved));
+            }
+        }
+
+        for (int mask = 0; mask < 256; mask++)
+        {
+            if (__builtin_popcount(mask) != 4)
+                continue;
+            CubieCube cube;
+            uint8_t nextM = 0, nextS = 0;
+            for (int slot = 0; slot < 8; slot++)
+                cube.ep[slot] = static_cast<uint8_t>(mask & (1 << slot) ? SLICE_SLOTS[0][nextM++] : SLICE_SLOTS[1][nextS++]);
+            int coord = mSliceCoord(cube);
+            for (int m = 0; m < NUM_PHASE3_MOVES; m++)
+            {
+                CubieCube child = cube;
+                child.move(PHASE3_MOVES[m]);
+                mSliceMove[coord][m] = static_cast<uint8_t>(mSliceCoord(child));
+            }
+        }
+
+        uint8_t identity[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        phase3Goal = cornerCoset(identity) * NUM_M_SLICE + mSliceCoord(CubieCube());
+        cosetDistance = buildByteTable(PHASE3_STATES, phase3Goal, NUM_PHASE3_MOVES, [&](int i, int m) {
+            return cornerCosetMove[i / NUM_M_SLICE][m] * NUM_M_SLICE + mSliceMove[i % NUM_M_SLICE][m];
+        });
+    }
+
+    // Phase 4: G3 itself, through move tables for the corners and each slice.
+    {
+        for (int h = 0; h < NUM_HALF_TURN_CORNERS; h++)
+        {
+            for (int m = 0; m < NUM_PHASE4_MOVES; m++)
+            {
+                uint8_t moved[8];
+                moveCorners(halfTurnCorners[h], PHASE4_MOVES[m], moved);
+                halfTurnCornerMove[h][m] = static_cast<uint8_t>(halfTurnCornerIndex(moved));
+            }
+        }
+        for (int rank = 0; rank < 24; rank++)
+        {
+            uint8_t perm[4];
+            permutationUnrank(rank, perm, 4);
+            int inversions = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                for (int j = i + 1; j < 4; j++)
+                    inversions += perm[i] > perm[j];
+            }
+            permParity[rank] = static_cast<uint8_t>(inversions & 1);
+
+            for (int slice = 0; slice < 3; slice++)
+            {
+                CubieCube cube;
+                for (int i = 0; i < 4; i++)
+                    cube.ep[SLICE_SLOTS[slice][i]] = static_cast<uint8_t>(SLICE_SLOTS[slice][perm[i]]);
+                for (int m = 0; m < NUM_PHASE4_MOVES; m++)
+                {
+                    CubieCube child = cube;
+                    child.move(PHASE4_MOVES[m]);
+                    slicePermMove[slice][rank][m] = static_cast<uint8_t>(slicePerm(child, slice));
+                }
+            }
+        }
+
+        // Half-turn-only positions are at most 15 moves from solved.
+        halfTurnDistance = buildNibbleTable(PHASE4_STATES, 0, NUM_PHASE4_MOVES, 15, [&](int i, int m) {
+            int c[4];
+            phase4Decode(i, c);
+            return phase4Index(halfTurnCornerMove[c[0]][m], slicePermMove[0][c[1]][m], slicePermMove[1][c[2]][m],
+                               slicePermMove[2][c[3]][m]);
+        });
+    }
+}
+
+const ThistlethwaiteSolver::Tables &ThistlethwaiteSolver::tables()
+{
+    static const Tables shared;
+    return shared;
+}
+
+void ThistlethwaiteSolver::prepareTables()
+{
+    tables();
+}
+
+size_t ThistlethwaiteSolver::tableBytes()
+{
+    const Tables &t = tables();
+    return sizeof(Tables) + t.flipDistance.size() + t.twistSliceDistance.size() + t.cosetDistance.size() +
+           t.halfTurnDistance.size();
+}
+
+ThistlethwaiteSolver::ThistlethwaiteSolver() : t(tables())
+{
+}
+
+// Walks down an exact distance table on the cubie state: some move of the
+// phase always gets one closer.
+template <typename Distance>
+static bool descend(CubieCube &cube, const Move *moves, int numMoves, Distance distance, std::vector<Move> &out)
+{
+    for (int d = distance(cube); d > 0; d--)
+    {
+        int m = 0;
+        CubieCube child;
+        for (; m < numMoves; m++)
+        {
+            child = cube;
+            child.move(moves[m]);
+            if (distance(child) == d - 1)
+                break;
+        }
+        if (m == numMoves)
+            return false;
+        cube = child;
+        out.push_back(moves[m]);
+    }
+    return true;
+}
+
+ThistlethwaiteResult ThistlethwaiteSolver::solve(const CubieCube &cube) const
+{
+    ThistlethwaiteResult result;
+    if (validateCubie(cube) != FaceletError::NONE)
+        return result;
+    RUBIKS_PROFILE_SCOPE("Thistlethwaite::solve");
+    auto start = std::chrono::steady_clock::now();
+
+    CubieCube state = cube;
+    std::vector<Move> &moves = result.solution;
+    size_t phaseStart = 0;
+
+    Move all[NUM_MOVES];
+    for (int m = 0; m < NUM_MOVES; m++)
+        all[m] = static_cast<Move>(m);
+    bool ok = descend(state, all, NUM_MOVES, [&](const CubieCube &c) { return t.flipDistance[flipCoord(c)]; }, moves);
+    result.phaseLength[0] = static_cast<int>(moves.size() - phaseStart);
+    phaseStart = moves.size();
+
+    ok = ok && descend(state, PHASE2_MOVES, NUM_PHASE2_MOVES,
+                       [&](const CubieCube &c) { return getNibble(t.twistSliceDistance, twistCoord(c) * NUM_SLICE + sliceCoord(c)); },
+                       moves);
+    result.phaseLength[1] = static_cast<int>(moves.size() - phaseStart);
+    phaseStart = moves.size();
+
+    // Phases 3 and 4 walk their coordinates through move tables and only
+    // update the cube at the end.
+    if (ok)
+    {
+        int coset = t.cornerCoset(state.cp), mSlice = mSliceCoord(state);
+        for (int d = t.cosetDistance[coset * NUM_M_SLICE + mSlice]; d > 0 && ok; d--)
+        {
+            int m = 0;
+            while (m < NUM_PHASE3_MOVES &&
+                   t.cosetDistance[t.cornerCosetMove[coset][m] * NUM_M_SLICE + t.mSliceMove[mSlice][m]] != d - 1)
+                m++;
+            ok = m < NUM_PHASE3_MOVES;
+            if (ok)
+            {
+                coset = t.cornerCosetMove[coset][m];
+                mSlice = t.mSliceMove[mSlice][m];
+                moves.push_back(PHASE3_MOVES[m]);
+            }
+        }
+        state.apply(moves.data() + phaseStart, moves.size() - phaseStart);
+    }
+    result.phaseLength[2] = static_cast<int>(moves.size() - phaseStart);
+    phaseStart = moves.size();
+
+    if (ok)
+    {
+        int corners = t.halfTurnCornerIndex(state.cp);
+        int mPerm = slicePerm(state, 0), sPerm = slicePerm(state, 1), ePerm = slicePerm(state, 2);
+        ok = corners >= 0;
+        for (int d = ok ? getNibble(t.halfTurnDistance, t.phase4Index(corners, mPerm, sPerm, ePerm)) : 0; d > 0 && ok; d--)
+        {
+            int m = 0;
+            while (m < NUM_PHASE4_MOVES &&
+                   getNibble(t.halfTurnDistance, t.phase4Index(t.halfTurnCornerMove[corners][m], t.slicePermMove[0][mPerm][m],
+                                                               t.slicePermMove[1][sPerm][m], t.slicePermMove[2][ePerm][m])) != d - 1)
+                m++;
+            ok = m < NUM_PHASE4_MOVES;
+            if (ok)
+            {
+                corners = t.halfTurnCornerMove[corners][m];
+                mPerm = t.slicePermMove[0][mPerm][m];
+                sPerm = t.slicePermMove[1][sPerm][m];
+                ePerm = t.slicePermMove[2][ePerm][m];
+                moves.push_back(PHASE4_MOVES[m]);
+            }
+        }
+        state.apply(moves.data() + phaseStart, moves.size() - phaseStart);
+    }
+    result.phaseLength[3] = static_cast<int>(moves.size() - phaseStart);
+
+    // Phase boundaries can leave two turns of one face next to each other.
+    moves.resize(simplifyMoves(moves.data(), moves.size()));
+    result.solved = ok && state.isSolved();
+    result.micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+ThistlethwaiteResult ThistlethwaiteSolver::solve(const RubiksCube &cube) const
+{
+    CubieCube cubie;
+    if (!cubie.fromCube(cube))
+        return ThistlethwaiteResult();
+    return solve(cubie);
+}
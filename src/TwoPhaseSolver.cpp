@@ -0,0 +1,298 @@
+#include "TwoPhaseSolver.h"
+#include "Coordinates.h"
+#include "Facelets.h"
+#include "Profiler.h"
+#include <algorithm>
+
+// The moves that keep the cube in the phase-2 subgroup.
+static const Move PHASE2_MOVES[] = {Move::U, Move::U_PRIME, Move::U2, Move::D, Move::D_PRIME, Move::D2,
+                                    Move::L2, Move::F2, Move::R2, Move::B2};
+static const int NUM_PHASE2_MOVES = 10;
+
+// Phase 2 never needs more moves than this.
+static const int MAX_PHASE2_LENGTH = 18;
+
+// The search checks the deadline and cancel flag once per this many nodes.
+static const uint64_t STOP_CHECK_INTERVAL = 1024;
+
+static const uint8_t UNSEEN = 0xFF;
+
+struct TwoPhaseSolver::Tables
+{
+    // Move tables: coordinate * moves + move -> coordinate after the move.
+    std::vector<uint16_t> twistMove, flipMove, sliceMove;
+    std::vector<uint16_t> cornerPermMove, udEdgePermMove, slicePermMove;
+
+    // Pruning tables: exact distances in the coordinate pair's own space,
+    // a lower bound on the phase's distance.
+    std::vector<uint8_t> twistSlicePrune, flipSlicePrune;
+    std::vector<uint8_t> cornerSlicePrune, edgeSlicePrune;
+
+    Tables();
+};
+
+// Builds a move table by setting each coordinate on a solved cube and
+// reading it back after every move.
+template <typename Get, typename Set>
+static std::vector<uint16_t> buildMoveTable(int size, const Move *moves, int numMoves, Get get, Set set)
+{
+    std::vector<uint16_t> table(size * numMoves);
+    for (int coord = 0; coord < size; coord++)
+    {
+        CubieCube cube;
+        set(cube, coord);
+        for (int m = 0; m < numMoves; m++)
+        {
+            CubieCube child = cube;
+            child.move(moves[m]);
+            table[coord * numMoves + m] = static_cast<uint16_t>(get(child));
+        }
+    }
+    return table;
+}
+
+// Breadth-first search over the product of two coordinates, index a * sizeB + b.
+static std::vector<uint8_t> buildPruneTable(int sizeA, const std::vector<uint16_t> &moveA, int sizeB,
+                                            const std::vector<uint16_t> &moveB, int numMoves)
+{
+    std::vector<uint8_t> dist(static_cast<size_t>(sizeA) * sizeB, UNSEEN);
+    dist[0] = 0;
+    bool grew = true;
+    for (int depth = 0; grew; depth++)
+    {
+        grew = false;
+        for (size_t i = 0; i < dist.size(); i++)
+        {
+            if (dist[i] != depth)
+                continue;
+            int a = static_cast<int>(i / sizeB), b = static_cast<int>(i % sizeB);
+            for (int m = 0; m < numMoves; m++)
+            {
+                size_t j = static_cast<size_t>(moveA[a * numMoves + m]) * sizeB + moveB[b * numMoves + m];
+                if (dist[j] == UNSEEN)
+                {
+                    dist[j] = static_cast<uint8_t>(depth + 1);
+                    grew = true;
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+TwoPhaseSolver::Tables::Tables()
+{
+    RUBIKS_PROFILE_SCOPE("TwoPhase::tables");
+    Move all[NUM_MOVES];
+    for (int m = 0; m < NUM_MOVES; m++)
+        all[m] = static_cast<Move>(m);
+
+    twistMove = buildMoveTable(NUM_TWIST, all, NUM_MOVES, twistCoord, setTwistCoord);
+    flipMove = buildMoveTable(NUM_FLIP, all, NUM_MOVES, flipCoord, setFlipCoord);
+    sliceMove = buildMoveTable(NUM_SLICE, all, NUM_MOVES, sliceCoord, setSliceCoord);
+    cornerPermMove = buildMoveTable(NUM_CORNER_PERM, PHASE2_MOVES, NUM_PHASE2_MOVES, cornerPermCoord, setCornerPermCoord);
+    udEdgePermMove = buildMoveTable(NUM_UD_EDGE_PERM, PHASE2_MOVES, NUM_PHASE2_MOVES, udEdgePermCoord, setUdEdgePermCoord);
+    slicePermMove = buildMoveTable(NUM_SLICE_PERM, PHASE2_MOVES, NUM_PHASE2_MOVES, slicePermCoord, setSlicePermCoord);
+
+    twistSlicePrune = buildPruneTable(NUM_TWIST, twistMove, NUM_SLICE, sliceMove, NUM_MOVES);
+    flipSlicePrune = buildPruneTable(NUM_FLIP, flipMove, NUM_SLICE, sliceMove, NUM_MOVES);
+    cornerSlicePrune = buildPruneTable(NUM_CORNER_PERM, cornerPermMove, NUM_SLICE_PERM, slicePermMove, NUM_PHASE2_MOVES);
+    edgeSlicePrune = buildPruneTable(NUM_UD_EDGE_PERM, udEdgePermMove, NUM_SLICE_PERM, slicePermMove, NUM_PHASE2_MOVES);
+}
+
+const TwoPhaseSolver::Tables &TwoPhaseSolver::tables()
+{
+    static const Tables shared;
+    return shared;
+}
+
+void TwoPhaseSolver::prepareTables()
+{
+    tables();
+}
+
+size_t TwoPhaseSolver::tableBytes()
+{
+    const Tables &t = tables();
+    size_t moveEntries = t.twistMove.size() + t.flipMove.size() + t.sliceMove.size() + t.cornerPermMove.size() +
+                         t.udEdgePermMove.size() + t.slicePermMove.size();
+    return moveEntries * sizeof(uint16_t) + t.twistSlicePrune.size() + t.flipSlicePrune.size() + t.cornerSlicePrune.size() +
+           t.edgeSlicePrune.size();
+}
+
+TwoPhaseSolver::TwoPhaseSolver() : t(tables())
+{
+}
+
+TwoPhaseResult TwoPhaseSolver::solve(const CubieCube &cube, const TwoPhaseOptions &opts)
+{
+    result = TwoPhaseResult{SearchOutcome::EXHAUSTED, false, {}, 0};
+    if (validateCubie(cube) != FaceletError::NONE)
+    {
+        result.outcome = SearchOutcome::INVALID_CUBE;
+        return result;
+    }
+
+    options = &opts;
+    start = cube;
+    stopped = false;
+    bestLength = std::min(opts.maxLength, static_cast<int>(MAX_LENGTH)) + 1;
+
+    int twist = twistCoord(cube), flip = flipCoord(cube), slice = sliceCoord(cube);
+    int h = std::max(t.twistSlicePrune[twist * NUM_SLICE + slice], t.flipSlicePrune[flip * NUM_SLICE + slice]);
+
+    RUBIKS_PROFILE_SCOPE("TwoPhase::solve");
+
+    // Each deeper phase 1 can only pay off while it is shorter than the best
+    // solution so far.
+    for (int depth = h; depth < bestLimit() && !stopped; depth++)
+    {
+        phase1(twist, flip, slice, 0, depth, -1);
+    }
+    return result;
+}
+
+// Solutions must be shorter than this: the best of this search and of any
+// searches sharing its bound.
+int TwoPhaseSolver::bestLimit() const
+{
+    if (options->sharedBest == nullptr)
+        return bestLength;
+    return std::min(bestLength, options->sharedBest->load(std::memory_order_relaxed));
+}
+
+bool TwoPhaseSolver::shouldStop()
+{
+    if (++result.nodes % STOP_CHECK_INTERVAL != 0)
+        return stopped;
+    if (options->cancel != nullptr && options->cancel->load(std::memory_order_relaxed))
+    {
+        result.outcome = SearchOutcome::CANCELLED;
+        stopped = true;
+    }
+    else if (options->sharedBest != nullptr && options->sharedBest->load(std::memory_order_relaxed) <= options->targetLength)
+    {
+        // Another search reached the target.
+        result.outcome = SearchOutcome::TARGET_REACHED;
+        stopped = true;
+    }
+    else if (std::chrono::steady_clock::now() >= options->deadline)
+    {
+        result.outcome = SearchOutcome::DEADLINE;
+        stopped = true;
+    }
+    return stopped;
+}
+
+// Returns true when the whole search should stop.
+bool TwoPhaseSolver::phase1(int twist, int flip, int slice, int depth, int togo, int lastFace)
+{
+    RUBIKS_PROFILE_COUNT("TwoPhase::phase1Nodes", 1);
+    if (shouldStop())
+        return true;
+
+    if (togo == 0)
+    {
+        // A phase 1 ending in a phase-2 move would also have been found one
+        // move shorter, so only sequences ending in a quarter turn of R, L,
+        // F or B are passed on.
+        if (twist != 0 || flip != 0 || slice != 0)
+            return false;
+        if (depth > 0)
+        {
+            Move last = path[depth - 1];
+            int face = moveFace(last);
+            bool sideQuarterTurn = face != 0 && face != 5 && moveQuarterTurns(last) != 2;
+            if (!sideQuarterTurn)
+                return false;
+        }
+        return startPhase2(depth);
+    }
+
+    for (int m = 0; m < NUM_MOVES; m++)
+    {
+        int face = m / 3;
+        if (!isCanonicalAfter(face, lastFace))
+            continue;
+        int nextTwist = t.twistMove[twist * NUM_MOVES + m];
+        int nextFlip = t.flipMove[flip * NUM_MOVES + m];
+        int nextSlice = t.sliceMove[slice * NUM_MOVES + m];
+        int h = std::max(t.twistSlicePrune[nextTwist * NUM_SLICE + nextSlice], t.flipSlicePrune[nextFlip * NUM_SLICE + nextSlice]);
+        if (h > togo - 1)
+            continue;
+        path[depth] = static_cast<Move>(m);
+        if (phase1(nextTwist, nextFlip, nextSlice, depth + 1, togo - 1, face))
+            return true;
+    }
+    return false;
+}
+
+bool TwoPhaseSolver::startPhase2(int phase1Length)
+{
+    int maxDepth = std::min(MAX_PHASE2_LENGTH, bestLimit() - 1 - phase1Length);
+    if (maxDepth < 0)
+        return false;
+    RUBIKS_PROFILE_SCOPE("TwoPhase::phase2");
+
+    CubieCube cube = start;
+    cube.apply(path, phase1Length);
+    int cornerPerm = cornerPermCoord(cube), udEdgePerm = udEdgePermCoord(cube), slicePerm = slicePermCoord(cube);
+    int h = std::max(t.cornerSlicePrune[cornerPerm * NUM_SLICE_PERM + slicePerm], t.edgeSlicePrune[udEdgePerm * NUM_SLICE_PERM + slicePerm]);
+    int lastFace = phase1Length > 0 ? moveFace(path[phase1Length - 1]) : -1;
+
+    for (int depth = h; depth <= maxDepth; depth++)
+    {
+        if (!phase2(cornerPerm, udEdgePerm, slicePerm, phase1Length, depth, lastFace))
+            continue;
+        if (stopped)
+            return true;
+
+        bestLength = phase1Length + depth;
+        if (options->sharedBest != nullptr)
+        {
+            int shared = options->sharedBest->load(std::memory_order_relaxed);
+            while (bestLength < shared && !options->sharedBest->compare_exchange_weak(shared, bestLength))
+            {
+            }
+        }
+        result.found = true;
+        result.solution.assign(path, path + bestLength);
+        if (options->onSolution)
+            options->onSolution(result.solution);
+        if (bestLength <= options->targetLength)
+        {
+            result.outcome = SearchOutcome::TARGET_REACHED;
+            stopped = true;
+        }
+        return stopped;
+    }
+    return stopped;
+}
+
+// Returns true once solved or when the search should stop.
+bool TwoPhaseSolver::phase2(int cornerPerm, int udEdgePerm, int slicePerm, int depth, int togo, int lastFace)
+{
+    RUBIKS_PROFILE_COUNT("TwoPhase::phase2Nodes", 1);
+    if (shouldStop())
+        return true;
+
+    if (togo == 0)
+        return cornerPerm == 0 && udEdgePerm == 0 && slicePerm == 0;
+
+    for (int i = 0; i < NUM_PHASE2_MOVES; i++)
+    {
+        int face = moveFace(PHASE2_MOVES[i]);
+        if (!isCanonicalAfter(face, lastFace))
+            continue;
+        int nextCorner = t.cornerPermMove[cornerPerm * NUM_PHASE2_MOVES + i];
+        int nextEdge = t.udEdgePermMove[udEdgePerm * NUM_PHASE2_MOVES + i];
+        int nextSlice = t.slicePermMove[slicePerm * NUM_PHASE2_MOVES + i];
+        int h = std::max(t.cornerSlicePrune[nextCorner * NUM_SLICE_PERM + nextSlice], t.edgeSlicePrune[nextEdge * NUM_SLICE_PERM + nextSlice]);
+        if (h > togo - 1)
+            continue;
+        path[depth] = PHASE2_MOVES[i];
+        if (phase2(nextCorner, nextEdge, nextSlice, depth + 1, togo - 1, face))
+            return true;
+    }
+    return false;
+}
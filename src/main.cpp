@@ -1,9 +1,833 @@
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
 // 1. Change the include to the bitboard model.
 #include "RubiksCubeBitboard.h"
+#include "RubiksCube1DArray.h"
+#include "AsyncSolver.h"
+#include "CfopSolver.h"
+#include "CubeRenderer.h"
+#include "ExternalBFS.h"
+#include "IDAstarSolver.h"
+#include "PatternDatabase.h"
+#include "PeepholeOptimizer.h"
+#include "PocketSolver.h"
+#include "Facelets.h"
+#include "ScrambleGenerator.h"
+#include "SequenceEnumerator.h"
+#include "Solver.h"
+#include "StateFile.h"
+#include "ThistlethwaiteSolver.h"
+#include <atomic>
+#include <random>
+#include <thread>
 
-int main()
+// Writes `count` scrambled states to a binary state file, numbered from 0.
+// Move-walk scrambles of up to STATE_FILE_MAX_SOLUTION moves also store
+// their inverse as a known solution.
+static int writeScrambleFile(const std::string &path, ScrambleGenerator &generator, size_t count, size_t length, bool randomState)
 {
+    StateFileWriter writer;
+    if (!writer.create(path, STATE_FILE_IDS | STATE_FILE_SOLUTIONS))
+    {
+        std::cerr << "Cannot create " << path << '\n';
+        return 1;
+    }
+
+    std::vector<Move> moves(length);
+    std::vector<Move> solution(length);
+    for (size_t n = 0; n < count; n++)
+    {
+        bool ok;
+        if (randomState)
+        {
+            ok = writer.append(packState(generator.randomState()), n);
+        }
+        else
+        {
+            generator.randomMoves(moves.data(), length);
+            CubieCube cube;
+            cube.apply(moves.data(), length);
+            for (size_t i = 0; i < length; i++)
+                solution[i] = inverse(moves[length - 1 - i]);
+            bool fits = length <= STATE_FILE_MAX_SOLUTION;
+            ok = writer.append(packState(cube), n, fits ? solution.data() : nullptr, fits ? length : 0);
+        }
+        if (!ok)
+            break;
+    }
+    if (!writer.close())
+    {
+        std::cerr << "Failed writing " << path << '\n';
+        return 1;
+    }
+    std::cout << "Wrote " << count << " states to " << path << '\n';
+    return 0;
+}
+
+// Usage: rubiks_solver scramble [count] [--length N] [--seed S] [--random-state] [--output FILE]
+// Prints `count` scrambles, one per line: canonical random move walks, or with
+// --random-state uniformly random states as standard facelet strings.
+// With --output the states are written to a binary state file instead.
+static int runScramble(int argc, char *argv[])
+{
+    size_t count = 1;
+    size_t length = 25;
+    uint64_t seed = std::random_device{}();
+    bool randomState = false;
+    std::string outputPath;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--length" && i + 1 < argc)
+            length = static_cast<size_t>(std::atol(argv[++i]));
+        else if (arg == "--output" && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--random-state")
+            randomState = true;
+        else
+            count = static_cast<size_t>(std::atol(argv[i]));
+    }
+
+    ScrambleGenerator generator(seed);
+    if (!outputPath.empty())
+    {
+        return writeScrambleFile(outputPath, generator, count, length, randomState);
+    }
+    if (randomState)
+    {
+        // Written in batches of 4096 states, one write each.
+        std::string text;
+        CubeRenderer renderer(text, RenderFormat::FACELETS);
+        renderer.reserve(4096);
+        for (size_t n = 0; n < count; n++)
+        {
+            renderer.add(generator.randomState());
+            if (renderer.count() == 4096)
+                renderer.flush(std::cout);
+        }
+        renderer.flush(std::cout);
+        return 0;
+    }
+
+    std::vector<Move> moves(length);
+    for (size_t n = 0; n < count; n++)
+    {
+        generator.randomMoves(moves.data(), length);
+        std::cout << formatMoves(moves.data(), length) << '\n';
+    }
+    return 0;
+}
+
+// Solves `cube` with the two-phase solver in the background, printing each
+// shorter solution as it arrives, until the time limit. `variants` views of
+// the cube are searched in parallel.
+static int runTwoPhase(const RubiksCube &cube, int millis, int variants)
+{
+    TwoPhaseSolver::prepareTables();
+    auto start = std::chrono::steady_clock::now();
+    AsyncSolver solver(30, 0, variants);
+    SolveHandle handle = solver.solve(cube, start + std::chrono::milliseconds(millis));
+
+    int printed = 0;
+    bool done = false;
+    while (!done)
+    {
+        done = handle.waitUntil(std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+        if (handle.improvements() > printed)
+        {
+            printed = handle.improvements();
+            std::vector<Move> best = handle.bestSolution();
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << best.size() << " moves after " << elapsed << " ms: " << formatMoves(best.data(), best.size()) << std::endl;
+        }
+    }
+
+    if (handle.status() == SolveHandle::Status::INVALID_CUBE)
+    {
+        std::cerr << "The cube cannot be solved." << std::endl;
+        return 1;
+    }
+    std::vector<Move> best = handle.bestSolution();
+    std::cout << "Solution: " << formatMoves(best.data(), best.size()) << std::endl;
+    return handle.hasSolution() ? 0 : 1;
+}
+
+// Usage: rubiks_solver solve [scramble_length | --scramble "R U R' U'" | --facelets STRING] [--seed S] [--stats]
+//                            [--two-phase MILLISECONDS [--variants N]]
+// Scrambles a cube (or loads it from a facelet string), solves it with IDA*, verifies the solution and, with
+// --stats, prints the search statistics as one JSON line. With --two-phase it uses the two-phase solver
+// instead and reports every improvement found within the time limit; --variants searches up to 6 rotated
+// and inverted views of the cube in parallel (default 1).
+static int runSolve(int argc, char *argv[])
+{
+    unsigned int scrambleLength = 5;
+    std::string scrambleText;
+    std::string facelets;
+    uint64_t seed = std::random_device{}();
+    bool printStats = false;
+    int twoPhaseMillis = -1;
+    int variants = 1;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--stats")
+            printStats = true;
+        else if (arg == "--variants" && i + 1 < argc)
+            variants = std::atoi(argv[++i]);
+        else if (arg == "--two-phase" && i + 1 < argc)
+            twoPhaseMillis = std::atoi(argv[++i]);
+        else if (arg == "--scramble" && i + 1 < argc)
+            scrambleText = argv[++i];
+        else if (arg == "--facelets" && i + 1 < argc)
+            facelets = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+            scrambleLength = static_cast<unsigned int>(std::atoi(argv[i]));
+    }
+
+    RubiksCube1DArray cube;
+    if (!facelets.empty())
+    {
+        FaceletError error = parseFacelets(facelets, cube);
+        if (error != FaceletError::NONE)
+        {
+            std::cerr << "Invalid facelets: " << faceletErrorName(error) << std::endl;
+            return 1;
+        }
+    }
+    else if (!scrambleText.empty())
+    {
+        std::vector<Move> scramble;
+        if (!parseAlgorithm(scrambleText, scramble))
+        {
+            std::cerr << "Invalid scramble: " << scrambleText << std::endl;
+            return 1;
+        }
+        cube.apply(scramble.data(), scramble.size());
+    }
+    else
+    {
+        ScrambleGenerator generator(seed);
+        cube.randomShuffle(scrambleLength, generator);
+    }
+
+    if (twoPhaseMillis >= 0)
+    {
+        return runTwoPhase(cube, twoPhaseMillis, variants);
+    }
+
+    IDAstarSolver<RubiksCube1DArray> solver(cube);
+    std::vector<Move> solution = solver.solve();
+
+    RubiksCube1DArray check = cube;
+    check.apply(solution.data(), solution.size());
+
+    std::cout << "Solution: " << formatMoves(solution.data(), solution.size());
+    std::cout << (check.isSolved() ? "" : " (does not solve the cube)") << std::endl;
+
+    if (printStats)
+    {
+#if RUBIKS_STATS_ENABLED
+        std::cout << solver.getStats().toJson() << std::endl;
+#else
+        std::cerr << "Search statistics are compiled out of this build." << std::endl;
+#endif
+    }
+    return check.isSolved() ? 0 : 1;
+}
+
+// Usage: rubiks_solver optimize "R U R' ..." [--depth N]
+// Shortens a move sequence with the peephole optimizer and prints the result.
+static int runOptimize(int argc, char *argv[])
+{
+    std::string text;
+    int depth = 5;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc)
+            depth = std::atoi(argv[++i]);
+        else
+            text = arg;
+    }
+
+    std::vector<Move> moves(text.size() + 1);
+    int length = parseMoves(text.c_str(), moves.data(), moves.size());
+    if (length < 0)
+    {
+        std::cerr << "Invalid moves: " << text << std::endl;
+        return 1;
+    }
+
+    PeepholeOptimizer optimizer(depth);
+    size_t optimized = optimizer.optimize(moves.data(), static_cast<size_t>(length));
+    std::cout << formatMoves(moves.data(), optimized) << " (" << length << " -> " << optimized << " moves)" << std::endl;
+    return 0;
+}
+
+// Usage: rubiks_solver bfs DIRECTORY [--depth N] [--memory-mb M]
+// Counts positions by distance from solved with the disk-based BFS, resuming
+// any earlier run in DIRECTORY.
+static int runBfs(int argc, char *argv[])
+{
+    std::string directory;
+    int depth = 6;
+    size_t memoryMb = 256;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc)
+            depth = std::atoi(argv[++i]);
+        else if (arg == "--memory-mb" && i + 1 < argc)
+            memoryMb = static_cast<size_t>(std::atol(argv[++i]));
+        else
+            directory = arg;
+    }
+    if (directory.empty())
+    {
+        std::cerr << "Usage: rubiks_solver bfs DIRECTORY [--depth N] [--memory-mb M]" << std::endl;
+        return 1;
+    }
+
+    ExternalBFS bfs(directory, memoryMb * 1024 * 1024 / sizeof(PackedState));
+    bool ok = bfs.run(depth, [](const BfsLayer &layer) {
+        std::cout << "depth " << layer.depth << ": " << layer.count << " positions, " << layer.seconds << " s, "
+                  << static_cast<uint64_t>(layer.statesPerSecond()) << " states/s" << std::endl;
+    });
+    if (!ok)
+    {
+        std::cerr << "I/O error in " << directory << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Usage: rubiks_solver pdb build corners|edges-first|edges-last FILE [--checkpoint-seconds S] [--encoding nibbles|mod3]
+//        rubiks_solver pdb pack FILE OUT
+//        rubiks_solver pdb info FILE
+// Builds a pattern database and writes it to FILE, repacks one with
+// distances mod 3 (half the size) into OUT, or describes one. A build saves
+// its progress to FILE.checkpoint every S seconds (default 60, 0 for never)
+// and picks up from there if it is run again after being stopped.
+static int runPdb(int argc, char *argv[])
+{
+    std::string command = argc > 2 ? argv[2] : "";
+    PatternKind kind;
+    if (command == "build" && argc >= 5 && parsePatternKind(argv[3], kind))
+    {
+        std::string path = argv[4];
+        PatternBuildOptions options;
+        options.checkpointPath = path + ".checkpoint";
+        for (int i = 5; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg == "--checkpoint-seconds" && i + 1 < argc)
+                options.checkpointSeconds = std::atof(argv[++i]);
+            else if (arg == "--encoding" && i + 1 < argc && !parsePdbEncoding(argv[++i], options.encoding))
+            {
+                std::cerr << "Unknown encoding " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        if (options.checkpointSeconds <= 0)
+            options.checkpointPath.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        auto elapsed = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+        double checkpointSeconds = 0;
+        int checkpoints = 0;
+        options.onLevel = [&](int depth, uint64_t entries) {
+            std::cout << "depth " << depth << ": " << entries << " entries, " << elapsed() << " s" << std::endl;
+        };
+        options.onCheckpoint = [&](const PatternCheckpointEvent &event) {
+            std::cout << (event.resumed ? "resumed from checkpoint" : event.ok ? "checkpoint" : "FAILED checkpoint")
+                      << " while building depth " << event.depth << ", entry " << event.position << ": " << (event.bytes >> 20) << " MB in "
+                      << event.seconds << " s" << std::endl;
+            if (!event.resumed)
+            {
+                checkpointSeconds += event.seconds;
+                checkpoints++;
+            }
+        };
+
+        PatternDatabase database;
+        if (!database.build(kind, options))
+        {
+            std::cerr << "Cannot allocate the table" << std::endl;
+            return 1;
+        }
+        std::cout << "Built in " << elapsed() << " s with " << pageKindName(database.memory().pageKind()) << " ("
+                  << (database.memory().hugeBytes() >> 20) << " MB huge); " << checkpoints << " checkpoints took "
+                  << checkpointSeconds << " s" << std::endl;
+        if (!database.save(path))
+        {
+            std::cerr << "Cannot write " << path << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (command == "pack" && argc == 5)
+    {
+        PatternDatabase database;
+        if (!database.load(argv[3]))
+        {
+            std::cerr << argv[3] << " is not a pattern database" << std::endl;
+            return 1;
+        }
+        if (!database.encodeMod3())
+        {
+            std::cerr << "Cannot allocate the table" << std::endl;
+            return 1;
+        }
+        if (!database.save(argv[4]))
+        {
+            std::cerr << "Cannot write " << argv[4] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (command == "info" && argc == 4)
+    {
+        PatternDatabase database;
+        if (!database.map(argv[3]))
+        {
+            std::cerr << argv[3] << " is not a pattern database" << std::endl;
+            return 1;
+        }
+        std::cout << patternKindName(database.kind()) << ": " << PatternDatabase::entryCount(database.kind())
+                  << " entries, " << pdbEncodingName(database.encoding()) << ", " << (database.memory().size() >> 20) << " MB, max distance " << database.maxDistance()
+                  << ", mapped with " << pageKindName(database.memory().pageKind()) << std::endl;
+        return 0;
+    }
+    std::cerr << "Usage: rubiks_solver pdb build corners|edges-first|edges-last FILE [--checkpoint-seconds S] [--encoding nibbles|mod3]"
+                 " | pdb pack FILE OUT | pdb info FILE"
+              << std::endl;
+    return 1;
+}
+
+// Usage: rubiks_solver enumerate LENGTH [--threads N] [--prefix-length P]
+// Walks every canonical move sequence of LENGTH moves, split by their first P
+// moves (default 2) over N threads, and counts them and the ones that bring
+// the cube back to solved.
+static int runEnumerate(int argc, char *argv[])
+{
+    int length = 5;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int prefixLength = 2;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--prefix-length" && i + 1 < argc)
+            prefixLength = std::max(0, std::atoi(argv[++i]));
+        else
+            length = std::atoi(argv[i]);
+    }
+    if (length < 0)
+    {
+        std::cerr << "Usage: rubiks_solver enumerate LENGTH [--threads N] [--prefix-length P] (LENGTH at least 0)" << std::endl;
+        return 1;
+    }
+    prefixLength = std::min(prefixLength, length);
+
+    std::vector<std::vector<Move>> prefixes = SequenceEnumerator<>::canonicalPrefixes(prefixLength);
+    std::atomic<size_t> nextPrefix(0);
+    std::atomic<uint64_t> sequences(0), solved(0);
+    auto start = std::chrono::steady_clock::now();
+    auto work = [&] {
+        uint64_t count = 0, identities = 0;
+        for (size_t p = nextPrefix++; p < prefixes.size(); p = nextPrefix++)
+        {
+            SequenceEnumerator<CubieCube> enumerator(CubieCube(), length, prefixes[p]);
+            while (enumerator.next())
+            {
+                count++;
+                identities += enumerator.state().isSolved();
+            }
+        }
+        sequences += count;
+        solved += identities;
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back(work);
+    for (std::thread &thread : pool)
+        thread.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << sequences << " canonical sequences of " << length << " moves, " << solved << " of them leave the cube solved ("
+              << prefixes.size() << " shards on " << threads << " threads, " << elapsed.count() << " s)" << std::endl;
+    return 0;
+}
+
+// Usage: rubiks_solver pocket [scramble_length | --scramble "R U F'"] [--seed S]
+// Scrambles a 2x2x2 cube and solves it optimally by table lookup.
+static int runPocket(int argc, char *argv[])
+{
+    size_t scrambleLength = 20;
+    std::string scrambleText;
+    uint64_t seed = std::random_device{}();
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--scramble" && i + 1 < argc)
+            scrambleText = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+            scrambleLength = static_cast<size_t>(std::atol(argv[i]));
+    }
+
+    std::vector<Move> scramble;
+    if (!scrambleText.empty())
+    {
+        if (!parseAlgorithm(scrambleText, scramble))
+        {
+            std::cerr << "Invalid scramble: " << scrambleText << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        scramble.resize(scrambleLength);
+        ScrambleGenerator generator(seed);
+        generator.randomMoves(scramble.data(), scrambleLength);
+    }
+
+    PocketCube cube;
+    cube.apply(scramble.data(), scramble.size());
+    std::cout << "Scramble: " << formatMoves(scramble.data(), scramble.size()) << std::endl;
+
+    PocketSolver solver;
+    std::vector<Move> solution;
+    solver.solve(cube, solution);
+    cube.apply(solution.data(), solution.size());
+    std::cout << "Solution: " << formatMoves(solution.data(), solution.size()) << " (" << solution.size() << " moves)";
+    std::cout << (cube.isSolved() ? "" : " (does not solve the cube)") << std::endl;
+    return cube.isSolved() ? 0 : 1;
+}
+
+// Usage: rubiks_solver cfop [scramble_length | --scramble "R U R' U'" | --facelets STRING] [--seed S]
+// Solves stage by stage the way CFOP is taught and prints each stage's moves and time.
+static int runCfop(int argc, char *argv[])
+{
+    unsigned int scrambleLength = 30;
+    std::string scrambleText;
+    std::string facelets;
+    uint64_t seed = std::random_device{}();
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--scramble" && i + 1 < argc)
+            scrambleText = argv[++i];
+        else if (arg == "--facelets" && i + 1 < argc)
+            facelets = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+            scrambleLength = static_cast<unsigned int>(std::atoi(argv[i]));
+    }
+
+    RubiksCube1DArray cube;
+    if (!facelets.empty())
+    {
+        FaceletError error = parseFacelets(facelets, cube);
+        if (error != FaceletError::NONE)
+        {
+            std::cerr << "Invalid facelets: " << faceletErrorName(error) << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::vector<Move> scramble;
+        if (!scrambleText.empty())
+        {
+            if (!parseAlgorithm(scrambleText, scramble))
+            {
+                std::cerr << "Invalid scramble: " << scrambleText << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            scramble.resize(scrambleLength);
+            ScrambleGenerator generator(seed);
+            generator.randomMoves(scramble.data(), scrambleLength);
+        }
+        cube.apply(scramble.data(), scramble.size());
+        std::cout << "Scramble: " << formatMoves(scramble.data(), scramble.size()) << std::endl;
+    }
+
+    CfopSolver::prepareTables();
+    CfopSolver solver;
+    CfopResult result;
+    if (!solver.solve(cube, result))
+    {
+        std::cerr << "The cube cannot be solved." << std::endl;
+        return 1;
+    }
+    for (int stage = 0; stage < NUM_CFOP_STAGES; stage++)
+    {
+        const CfopStageResult &s = result.stages[stage];
+        std::cout << cfopStageName(static_cast<CfopStage>(stage)) << ": " << formatMoves(s.moves.data(), s.moves.size()) << " ("
+                  << s.moves.size() << " moves, " << s.micros << " us)" << std::endl;
+    }
+
+    RubiksCube1DArray check = cube;
+    check.apply(result.solution.data(), result.solution.size());
+    std::cout << "Solution: " << formatMoves(result.solution.data(), result.solution.size()) << " (" << result.solution.size()
+              << " moves)" << (check.isSolved() ? "" : " (does not solve the cube)") << std::endl;
+    return check.isSolved() ? 0 : 1;
+}
+
+// Usage: rubiks_solver compare [count] [--seed S] [--two-phase-ms MS]
+// Solves the same random states with each table-driven solver and prints, per solver, the memory its tables
+// take, how long they took to build, and the average solution length and solve time. The two-phase solver
+// runs once on the cube as given and once on six views of it in parallel.
+static int runCompare(int argc, char *argv[])
+{
+    int count = 100;
+    int twoPhaseMillis = 50;
+    uint64_t seed = std::random_device{}();
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--two-phase-ms" && i + 1 < argc)
+            twoPhaseMillis = std::atoi(argv[++i]);
+        else
+            count = std::atoi(argv[i]);
+    }
+
+    std::vector<CubieCube> cubes;
+    ScrambleGenerator generator(seed);
+    for (int i = 0; i < count; i++)
+        cubes.push_back(generator.randomState());
+
+    auto millisSince = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto report = [&](const char *name, size_t bytes, double buildMillis, size_t moves, double millis, int failures) {
+        // Unsolved cubes add no moves, so the length is averaged over the solved ones.
+        int solved = std::max(count - failures, 1);
+        std::cout << name << ": tables " << bytes / 1024 << " KB built in " << buildMillis << " ms, " << double(moves) / solved
+                  << " moves and " << millis * 1000 / count << " us per solve";
+        if (failures > 0)
+            std::cout << ", " << failures << " not solved";
+        std::cout << std::endl;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    ThistlethwaiteSolver::prepareTables();
+    double buildMillis = millisSince(start);
+    ThistlethwaiteSolver thistlethwaite;
+    size_t moves = 0;
+    int failures = 0;
+    start = std::chrono::steady_clock::now();
+    for (const CubieCube &cube : cubes)
+    {
+        ThistlethwaiteResult result = thistlethwaite.solve(cube);
+        moves += result.solution.size();
+        failures += !result.solved;
+    }
+    report("Thistlethwaite", ThistlethwaiteSolver::tableBytes(), buildMillis, moves, millisSince(start), failures);
+
+    start = std::chrono::steady_clock::now();
+    CfopSolver::prepareTables();
+    buildMillis = millisSince(start);
+    CfopSolver cfop;
+    moves = 0;
+    failures = 0;
+    start = std::chrono::steady_clock::now();
+    for (const CubieCube &cube : cubes)
+    {
+        CfopResult result;
+        failures += !cfop.solve(cube, result);
+        moves += result.solution.size();
+    }
+    report("CFOP", CfopSolver::tableBytes(), buildMillis, moves, millisSince(start), failures);
+
+    start = std::chrono::steady_clock::now();
+    TwoPhaseSolver::prepareTables();
+    buildMillis = millisSince(start);
+    TwoPhaseSolver twoPhase;
+    moves = 0;
+    failures = 0;
+    start = std::chrono::steady_clock::now();
+    for (const CubieCube &cube : cubes)
+    {
+        TwoPhaseOptions options;
+        options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(twoPhaseMillis);
+        TwoPhaseResult result = twoPhase.solve(cube, options);
+        moves += result.solution.size();
+        failures += !result.found;
+    }
+    report("Two-phase", TwoPhaseSolver::tableBytes(), buildMillis, moves, millisSince(start), failures);
+
+    MultiAxisSolver multiAxis;
+    moves = 0;
+    failures = 0;
+    start = std::chrono::steady_clock::now();
+    for (const CubieCube &cube : cubes)
+    {
+        TwoPhaseOptions options;
+        options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(twoPhaseMillis);
+        TwoPhaseResult result = multiAxis.solve(cube, options);
+        moves += result.solution.size();
+        failures += !result.found;
+    }
+    report("Two-phase, 6 views", TwoPhaseSolver::tableBytes(), 0, moves, millisSince(start), failures);
+    return 0;
+}
+
+// Usage: rubiks_solver dispatch [count] [--policy optimal|bounded|fastest] [--max-length N]
+//                                [--scramble-max N] [--tables DIR] [--seed S] [--cache N]
+// Sends scrambles of random length (1 to --scramble-max, default 20) through
+// the adaptive Solver and prints where each policy routed them and how long
+// each engine took. Pattern databases are loaded from DIR, and built (and
+// saved there) if missing. --cache puts a solution cache of N entries in
+// front of the engines and prints its hit rate.
+static int runDispatch(int argc, char *argv[])
+{
+    int count = 100;
+    int scrambleMax = 20;
+    size_t cacheEntries = 0;
+    std::string tables;
+    SolveRequest request;
+    uint64_t seed = std::random_device{}();
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--policy" && i + 1 < argc)
+        {
+            std::string policy = argv[++i];
+            request.policy = policy == "optimal" ? SolvePolicy::OPTIMAL
+                             : policy == "bounded" ? SolvePolicy::BOUNDED
+                                                   : SolvePolicy::FASTEST;
+        }
+        else if (arg == "--max-length" && i + 1 < argc)
+            request.maxLength = std::atoi(argv[++i]);
+        else if (arg == "--scramble-max" && i + 1 < argc)
+            scrambleMax = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--tables" && i + 1 < argc)
+            tables = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--cache" && i + 1 < argc)
+            cacheEntries = std::strtoull(argv[++i], nullptr, 10);
+        else
+            count = std::atoi(argv[i]);
+    }
+
+    Solver solver;
+    solver.enableCache(cacheEntries);
+    int loaded = tables.empty() ? 0 : solver.loadPatternDatabases(tables);
+    if (loaded < NUM_PATTERN_KINDS)
+    {
+        std::cout << "Building " << NUM_PATTERN_KINDS - loaded << " pattern databases..." << std::endl;
+        solver.buildPatternDatabases(tables);
+    }
+    ThistlethwaiteSolver::prepareTables();
+    TwoPhaseSolver::prepareTables();
+
+    ScrambleGenerator generator(seed);
+    Xoshiro256 lengths(seed + 1);
+    int solved = 0;
+    size_t moves = 0;
+    double micros = 0;
+    for (int n = 0; n < count; n++)
+    {
+        std::vector<Move> scramble(1 + lengths.below(scrambleMax));
+        generator.randomMoves(scramble.data(), scramble.size());
+        CubieCube cube;
+        cube.apply(scramble.data(), scramble.size());
+        SolveResponse response = solver.solve(cube, request);
+        solved += response.solved;
+        moves += response.solution.size();
+        micros += response.micros;
+    }
+    std::cout << solved << " of " << count << " solved, " << double(moves) / std::max(solved, 1) << " moves and "
+              << micros / std::max(count, 1) << " us per request" << std::endl;
+    if (cacheEntries > 0)
+    {
+        CacheStats cache = solver.cacheStats();
+        std::cout << "Cache: " << cache.hits << " hits, " << cache.misses << " misses (" << cache.hitRate() * 100
+                  << "%), " << cache.size << " entries, " << cache.evictions << " evictions" << std::endl;
+    }
+
+    SolverStats stats = solver.stats();
+    for (int e = 0; e < NUM_SOLVER_ENGINES; e++)
+    {
+        const EngineStats &engine = stats.engines[e];
+        if (engine.calls == 0 && engine.routed == 0)
+            continue;
+        std::cout << "\n" << solverEngineName(static_cast<SolverEngine>(e)) << ": " << engine.routed << " answered, "
+                  << engine.calls << " runs" << std::endl;
+        for (int b = 0; b < LATENCY_BUCKETS; b++)
+        {
+            if (engine.latency[b] == 0)
+                continue;
+            uint64_t low = b == 0 ? 0 : uint64_t(1) << (b - 1);
+            std::cout << "  " << std::setw(9) << low << " us+ " << std::setw(7) << engine.latency[b] << " "
+                      << std::string(std::max<uint64_t>(1, engine.latency[b] * 40 / engine.calls), '#') << std::endl;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "solve")
+    {
+        return runSolve(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "scramble")
+    {
+        return runScramble(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "compare")
+    {
+        return runCompare(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "enumerate")
+    {
+        return runEnumerate(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "dispatch")
+    {
+        return runDispatch(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "cfop")
+    {
+        return runCfop(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "pocket")
+    {
+        return runPocket(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "bfs")
+    {
+        return runBfs(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "pdb")
+    {
+        return runPdb(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "optimize")
+    {
+        return runOptimize(argc, argv);
+    }
+
     // 2. Change the class being instantiated.
     RubiksCubeBitboard cube;
 
@@ -18,7 +842,6 @@ int main()
     std::cout << "Is the cube solved? " << (cube.isSolved() ? "Yes" : "No") << std::endl;
     std::cout << "------------------------------------" << std::endl;
 
-    // Note: The random shuffle will only use 'F' moves until you implement the others.
     std::cout << "Shuffling the cube with 5 random moves..." << std::endl;
     RubiksCubeBitboard fresh_cube;
     fresh_cube.randomShuffle(5);
@@ -26,4 +849,4 @@ int main()
     std::cout << "Is the cube solved? " << (fresh_cube.isSolved() ? "Yes" : "No") << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,46 @@
+// Checks that the solver front end rejects states that turning faces cannot
+// reach, for every policy, without starting a search. Run with `make test`.
+#include "Solver.h"
+#include <cstdio>
+#include <utility>
+
+// Generous: a rejected request does no search and takes microseconds.
+static constexpr double MAX_REJECT_MICROS = 100000;
+
+int main()
+{
+    std::pair<const char *, CubieCube> cubes[4];
+    cubes[0].first = "twisted corner";
+    cubes[0].second.co[0] = 1;
+    cubes[1].first = "flipped edge";
+    cubes[1].second.eo[0] = 1;
+    cubes[2].first = "swapped corners";
+    std::swap(cubes[2].second.cp[0], cubes[2].second.cp[1]);
+    cubes[3].first = "out-of-range corner";
+    cubes[3].second.cp[0] = 200;
+
+    const std::pair<const char *, SolvePolicy> policies[] = {
+        {"optimal", SolvePolicy::OPTIMAL}, {"bounded", SolvePolicy::BOUNDED}, {"fastest", SolvePolicy::FASTEST}};
+
+    Solver solver;
+    int failures = 0;
+    for (const auto &cube : cubes)
+    {
+        for (const auto &policy : policies)
+        {
+            SolveRequest request;
+            request.policy = policy.second;
+            SolveResponse response = solver.solve(cube.second, request);
+            bool ok = !response.solved && response.solution.empty() && response.engine == SolverEngine::NONE &&
+                      response.micros < MAX_REJECT_MICROS;
+            if (!ok)
+            {
+                std::printf("FAILED: %s, %s: solved=%d engine=%s %.0f us\n", cube.first, policy.first, response.solved,
+                            solverEngineName(response.engine), response.micros);
+                failures++;
+            }
+        }
+    }
+    std::printf("%s\n", failures == 0 ? "solver: all invalid states rejected" : "solver: failures");
+    return failures == 0 ? 0 : 1;
+}